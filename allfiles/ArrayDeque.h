@@ -0,0 +1,414 @@
+/** @file */
+#ifndef __ARRAYDEQUE_H
+#define __ARRAYDEQUE_H
+
+#include "Utility.h"
+#include<cstdio>
+
+/**
+ * An ArrayDeque is a double-ended queue stored in a circular array, so that
+ * elements can be added or removed at both ends in O(1) and accessed by
+ * index in O(1).
+ *
+ * The capacity of the array is always a power of two, so the position of
+ * an element is found with a mask instead of a division. The array doubles
+ * when it is full.
+ *
+ * The iterator iterates from the first element to the last.
+ */
+template <class E>
+class ArrayDeque {
+    private:
+    static const int DEFAULT_CAPACITY = 16;
+    int head, sz, mask;
+    E* data;
+
+    std::string toString(int x) const {
+        char s[20];
+        sprintf(s, "%d", x);
+        return std::string(s);
+    }
+
+    void checkBoundExclusive(int index) const {
+        if (index < 0 || index >= sz)
+            throw IndexOutOfBound("\nIndex out of Bound >>> Index: " + toString(index) + ", Size: " + toString(sz) + "\n");
+    }
+
+    E& at(int index) {
+        return data[(head + index) & mask];
+    }
+
+    const E& at(int index) const {
+        return data[(head + index) & mask];
+    }
+
+    static int roundUp(int n) {
+        int cap = 1;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+
+    /**
+     * Moves the elements to a new array of the specified capacity, the
+     * first element landing at index 0.
+     */
+    void reallocate(int newCap) {
+        E* newData = new E[newCap];
+        for (int i = 0; i < sz; ++i) newData[i] = at(i);
+        delete [] data;
+        data = newData;
+        head = 0;
+        mask = newCap - 1;
+    }
+
+    void init(int initialCapacity) {
+        int cap = roundUp(initialCapacity < 1 ? 1 : initialCapacity);
+        data = new E[cap];
+        mask = cap - 1;
+        head = sz = 0;
+    }
+
+    public:
+    class ConstIterator {
+        private:
+        int pos;
+        const ArrayDeque *deq;
+
+        public:
+        void init(const ArrayDeque *_deq) {
+            deq = _deq; pos = 0;
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return pos < deq->sz;
+        }
+
+        /**
+         * Returns the next element in the iteration.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        const E& next() {
+            if (pos >= deq->sz)
+                throw ElementNotExist("\nNo Such Element\n");
+            return deq->at(pos++);
+        }
+    };
+
+    class Iterator {
+        private:
+        int pos, last;
+        ArrayDeque *deq;
+
+        public:
+        void init(ArrayDeque *_deq) {
+            deq = _deq; pos = 0; last = -1;
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return pos < deq->sz;
+        }
+
+        /**
+         * Returns the next element in the iteration.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        E& next() {
+            if (pos >= deq->sz)
+                throw ElementNotExist("\nNo Such Element\n");
+            last = pos;
+            return deq->at(pos++);
+        }
+
+        /**
+         * Removes from the underlying collection the last element returned by the iterator.
+         * O(min(i, n - i)), i being the position of the element.
+         * @throw ElementNotExist
+         */
+        void remove() {
+            if (last < 0)
+                throw ElementNotExist("\nIllegal State\n");
+            deq->removeIndex(last);
+            pos--; last = -1;
+        }
+    };
+
+    /**
+     * Constructs an empty deque able to hold the specified number of
+     * elements before growing.
+     */
+    ArrayDeque(int initialCapacity = DEFAULT_CAPACITY) {
+        init(initialCapacity);
+    }
+
+    /**
+     * Constructs a deque containing the elements of the specified collection,
+     * in the order they are returned by the collection's iterator.
+     */
+    template <class E2>
+    explicit ArrayDeque(const E2& x) {
+        init(x.size());
+        addAll(*this, x);
+    }
+
+    /**
+     * Copy-constructor
+     */
+    ArrayDeque(const ArrayDeque& x) {
+        init(x.size());
+        addAll(*this, x);
+    }
+
+    /**
+     * Assignment operator
+     */
+    ArrayDeque& operator = (const ArrayDeque& x) {
+        if (this == &x) return *this;
+        clear();
+        addAll(*this, x);
+        return *this;
+    }
+
+    /**
+     * Destructor
+     */
+    ~ArrayDeque() {
+        delete [] data;
+    }
+
+    /**
+     * Returns an iterator over the elements from the first to the last.
+     */
+    Iterator iterator() {
+        Iterator Itr;
+        Itr.init(this);
+        return Itr;
+    }
+
+    /**
+     * Returns an CONST iterator over the elements from the first to the last.
+     */
+    ConstIterator constIterator() const {
+        ConstIterator CItr;
+        CItr.init(this);
+        return CItr;
+    }
+
+    /**
+     * Appends the specified element to the end of this deque.
+     * O(1) amortized
+     */
+    bool add(const E& e) {
+        addLast(e);
+        return true;
+    }
+
+    /**
+     * Inserts the specified element at the beginning of this deque.
+     * O(1) amortized
+     */
+    void addFirst(const E& elem) {
+        if (sz == mask + 1) reallocate((mask + 1) * 2);
+        head = (head - 1) & mask;
+        data[head] = elem;
+        sz++;
+    }
+
+    /**
+     * Inserts the specified element at the end of this deque.
+     * O(1) amortized
+     */
+    void addLast(const E& elem) {
+        if (sz == mask + 1) reallocate((mask + 1) * 2);
+        data[(head + sz) & mask] = elem;
+        sz++;
+    }
+
+    /**
+     * Removes all of the elements from this deque.
+     * O(1)
+     */
+    void clear() {
+        head = sz = 0;
+    }
+
+    /**
+     * Returns true if this deque contains the specified element.
+     * O(n)
+     */
+    bool contains(const E& e) const {
+        return indexOf(e) != -1;
+    }
+
+    /**
+     * Grows the array, if necessary, so that it can hold at least the
+     * specified number of elements.
+     * O(n)
+     */
+    void ensureCapacity(int minCapacity) {
+        if (minCapacity > mask + 1) reallocate(roundUp(minCapacity));
+    }
+
+    /**
+     * Returns a reference to the element at the specified position in this deque.
+     * O(1)
+     * @throw IndexOutOfBound
+     */
+    E& get(int index) {
+        checkBoundExclusive(index);
+        return at(index);
+    }
+
+    /**
+     * Returns a const reference to the element at the specified position in this deque.
+     * O(1)
+     * @throw IndexOutOfBound
+     */
+    const E& get(int index) const {
+        checkBoundExclusive(index);
+        return at(index);
+    }
+
+    /**
+     * Returns a reference to the first element in this deque.
+     * O(1)
+     * @throw ElementNotExist
+     */
+    E& getFirst() {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return data[head];
+    }
+
+    /**
+     * Returns a const reference to the first element in this deque.
+     * O(1)
+     * @throw ElementNotExist
+     */
+    const E& getFirst() const {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return data[head];
+    }
+
+    /**
+     * Returns a reference to the last element in this deque.
+     * O(1)
+     * @throw ElementNotExist
+     */
+    E& getLast() {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return at(sz - 1);
+    }
+
+    /**
+     * Returns a const reference to the last element in this deque.
+     * O(1)
+     * @throw ElementNotExist
+     */
+    const E& getLast() const {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return at(sz - 1);
+    }
+
+    /**
+     * Returns the index of the first occurrence of the specified element in this deque, or -1 if it does not contain the element.
+     * O(n)
+     */
+    int indexOf(const E& e) const {
+        for (int i = 0; i < sz; ++i)
+            if (e == at(i)) return i;
+        return -1;
+    }
+
+    /**
+     * Returns true if this deque contains no elements.
+     * O(1)
+     */
+    bool isEmpty() const {
+        return sz == 0;
+    }
+
+    /**
+     * Removes the element at the specified position in this deque, shifting
+     * the elements on the shorter side of it. Returns the removed element.
+     * O(min(index, n - index))
+     * @throw IndexOutOfBound
+     */
+    E removeIndex(int index) {
+        checkBoundExclusive(index);
+        E res = at(index);
+        if (index < sz - index - 1) {
+            for (int i = index; i > 0; --i) at(i) = at(i - 1);
+            head = (head + 1) & mask;
+        }
+        else {
+            for (int i = index; i < sz - 1; ++i) at(i) = at(i + 1);
+        }
+        sz--;
+        return res;
+    }
+
+    /**
+     * Removes the first occurrence of the specified element from this deque, if it is present.
+     * O(n)
+     */
+    bool remove(const E& e) {
+        int pos = indexOf(e);
+        if (pos == -1) return false;
+        removeIndex(pos); return true;
+    }
+
+    /**
+     * Removes and returns the first element of this deque.
+     * O(1)
+     * @throw ElementNotExist
+     */
+    E removeFirst() {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        E res = data[head];
+        head = (head + 1) & mask;
+        sz--;
+        return res;
+    }
+
+    /**
+     * Removes and returns the last element of this deque.
+     * O(1)
+     * @throw ElementNotExist
+     */
+    E removeLast() {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        sz--;
+        return at(sz);
+    }
+
+    /**
+     * Replaces the element at the specified position in this deque with the specified element.
+     * O(1)
+     * @throw IndexOutOfBound
+     */
+    E set(int index, const E& element) {
+        checkBoundExclusive(index);
+        E res = at(index);
+        at(index) = element;
+        return res;
+    }
+
+    /**
+     * Returns the number of elements in this deque.
+     * O(1)
+     */
+    int size() const {
+        return sz;
+    }
+};
+
+#endif
@@ -117,6 +117,122 @@ class ArrayList {
         }
     };
 
+    /**
+     * An iterator which moves in both directions and edits the list at its
+     * cursor. The cursor lies between the element previous() would return
+     * and the element next() would return.
+     */
+    class ListIterator {
+        private:
+        int pos, last;
+        ArrayList* arr;
+
+        public:
+        void init(ArrayList<E> *_arr, int _pos) {
+            arr = _arr; pos = _pos; last = -1;
+        }
+
+        /**
+         * Returns true if next() would return an element.
+         * O(1)
+         */
+        bool hasNext() {
+            return pos < arr->size();
+        }
+
+        /**
+         * Returns the next element and moves the cursor forward.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        E& next() {
+            if (pos >= arr->size())
+                throw ElementNotExist("\nNo Such Element\n");
+            last = pos;
+            return arr->get(pos++);
+        }
+
+        /**
+         * Returns true if previous() would return an element.
+         * O(1)
+         */
+        bool hasPrevious() {
+            return pos > 0;
+        }
+
+        /**
+         * Returns the previous element and moves the cursor backward.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        E& previous() {
+            if (pos == 0)
+                throw ElementNotExist("\nNo Such Element\n");
+            last = --pos;
+            return arr->get(pos);
+        }
+
+        /**
+         * Returns the index of the element next() would return.
+         * O(1)
+         */
+        int nextIndex() {
+            return pos;
+        }
+
+        /**
+         * Returns the index of the element previous() would return.
+         * O(1)
+         */
+        int previousIndex() {
+            return pos - 1;
+        }
+
+        /**
+         * Replaces the element last returned by next() or previous().
+         * O(1)
+         * @throw ElementNotExist
+         */
+        void set(const E& e) {
+            if (last < 0)
+                throw ElementNotExist("\nIllegal State\n");
+            arr->set(last, e);
+        }
+
+        /**
+         * Removes the element last returned by next() or previous().
+         * O(n)
+         * @throw ElementNotExist
+         */
+        void remove() {
+            if (last < 0)
+                throw ElementNotExist("\nIllegal State\n");
+            arr->removeIndex(last);
+            if (last < pos) pos--;
+            last = -1;
+        }
+
+        /**
+         * Inserts an element just before the cursor: next() is unaffected
+         * and previous() would return the new element.
+         * O(n)
+         */
+        void addBefore(const E& e) {
+            arr->add(pos++, e);
+            last = -1;
+        }
+
+        /**
+         * Inserts an element just after the cursor: next() would return
+         * the new element.
+         * O(n)
+         */
+        void addAfter(const E& e) {
+            arr->add(pos, e);
+            last = -1;
+        }
+    };
+
     void init(int initialCapacity) {
         cap = initialCapacity;
         data = new E[cap];
@@ -185,6 +301,18 @@ class ArrayList {
         return CItr;
     }
 
+    /**
+     * Returns a list iterator whose next() returns the element at the specified position.
+     * O(1)
+     * @throw IndexOutOfBound
+     */
+    ListIterator listIterator(int index = 0) {
+        checkBoundInclusive(index);
+        ListIterator LItr;
+        LItr.init(this, index);
+        return LItr;
+    }
+
     /**
      * Appends the specified element to the end of this list.
      * O(1)
@@ -0,0 +1,156 @@
+/** @file */
+#ifndef __BLOOMFILTER_H
+#define __BLOOMFILTER_H
+
+#include "Utility.h"
+#include<cstdlib>
+#include<cstring>
+#include<new>
+
+/**
+ * A blocked Bloom filter, an approximate set which answers ``definitely
+ * not present'' or ``maybe present''.
+ *
+ * The bits are grouped in blocks of 256 bits (eight 32-bit words, half a
+ * cache line). An element selects one block from its hash and sets one bit
+ * in each of the eight words, so a query costs a single cache miss at most.
+ * With the default 10 bits per element about 1% of the queries for absent
+ * elements answer ``maybe''.
+ *
+ * Template argument H is the same hash class as for HashSet, with a static
+ * function ``hashcode'' returning an int. The hash code is mixed before use,
+ * so an identity hash for integers is fine.
+ */
+template <class T, class H> class BloomFilter {
+    public:
+    static const int DEFAULT_BITS_PER_ELEMENT = 10;
+    private:
+    static const int WORDS_PER_BLOCK = 8;
+    unsigned int *blocks;
+    int blockNum, expected, bitsPerElem;
+
+    static unsigned long long mix(const T& elem) {
+        unsigned long long h = (unsigned int)H::hashcode(elem);
+        h *= 0x9E3779B97F4A7C15ULL;
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    unsigned int* blockOf(unsigned long long h) const {
+        return blocks + ((h >> 32) * blockNum >> 32) * WORDS_PER_BLOCK;
+    }
+
+    static unsigned int bitOf(unsigned long long h, int i) {
+        static const unsigned int SALT[WORDS_PER_BLOCK] = {
+            0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+            0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+        };
+        return 1U << (((unsigned int)h * SALT[i]) >> 27);
+    }
+
+    void init(int expectedElements, int bitsPerElement) {
+        expected = expectedElements > 1 ? expectedElements : 1;
+        bitsPerElem = bitsPerElement > 1 ? bitsPerElement : 1;
+        long long bits = (long long)expected * bitsPerElem;
+        blockNum = (int)((bits + 32 * WORDS_PER_BLOCK - 1) / (32 * WORDS_PER_BLOCK));
+        void *mem;
+        if (posix_memalign(&mem, 64, (size_t)blockNum * WORDS_PER_BLOCK * sizeof(unsigned int)) != 0)
+            throw std::bad_alloc();
+        blocks = (unsigned int*)mem;
+        clear();
+    }
+
+    public:
+    /**
+     * Constructs an empty filter sized for expectedElements elements.
+     */
+    BloomFilter(int expectedElements = 1024, int bitsPerElement = DEFAULT_BITS_PER_ELEMENT) {
+        init(expectedElements, bitsPerElement);
+    }
+
+    /**
+     * Constructs a filter holding all elements of the specified collection,
+     * sized for its current size.
+     */
+    template<class C> explicit BloomFilter(const C& c, int bitsPerElement = DEFAULT_BITS_PER_ELEMENT) {
+        init(c.size(), bitsPerElement);
+        addAll(*this, c);
+    }
+
+    /**
+     * Copy constructor
+     */
+    BloomFilter(const BloomFilter &c) {
+        init(c.expected, c.bitsPerElem);
+        memcpy(blocks, c.blocks, (size_t)blockNum * WORDS_PER_BLOCK * sizeof(unsigned int));
+    }
+
+    /**
+     * Assignment operator
+     */
+    BloomFilter& operator = (const BloomFilter &c) {
+        if (this == &c) return *this;
+        free(blocks);
+        init(c.expected, c.bitsPerElem);
+        memcpy(blocks, c.blocks, (size_t)blockNum * WORDS_PER_BLOCK * sizeof(unsigned int));
+        return *this;
+    }
+
+    /**
+     * Destructor
+     */
+    ~BloomFilter() {
+        free(blocks);
+    }
+
+    /**
+     * Records the specified element.
+     * O(1)
+     */
+    void add(const T& elem) {
+        unsigned long long h = mix(elem);
+        unsigned int *b = blockOf(h);
+        for (int i = 0; i < WORDS_PER_BLOCK; ++i) b[i] |= bitOf(h, i);
+    }
+
+    /**
+     * Returns false if the element was never added, true if it probably was.
+     * O(1), touching a single block.
+     */
+    bool mightContain(const T& elem) const {
+        unsigned long long h = mix(elem);
+        const unsigned int *b = blockOf(h);
+        for (int i = 0; i < WORDS_PER_BLOCK; ++i)
+            if ((b[i] & bitOf(h, i)) == 0) return false;
+        return true;
+    }
+
+    /**
+     * Forgets all elements.
+     * O(m), m being the number of bits.
+     */
+    void clear() {
+        memset(blocks, 0, (size_t)blockNum * WORDS_PER_BLOCK * sizeof(unsigned int));
+    }
+
+    /**
+     * Returns the number of elements the filter was sized for. Adding more
+     * than that raises the false positive rate.
+     */
+    int capacity() const {
+        return expected;
+    }
+
+    /**
+     * Returns the number of bits per element the filter was sized with.
+     */
+    int bitsPerElement() const {
+        return bitsPerElem;
+    }
+};
+
+#endif
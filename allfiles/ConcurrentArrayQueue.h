@@ -0,0 +1,142 @@
+/** @file */
+#ifndef __CONCURRENTARRAYQUEUE_H
+#define __CONCURRENTARRAYQUEUE_H
+
+#include "Utility.h"
+
+/**
+ * A bounded lock-free queue for many producers and many consumers, stored
+ * in a ring buffer whose capacity is a power of two, with the deque methods
+ * of LinkedList used by work queues (add, removeFirst, isEmpty).
+ *
+ * Every cell carries a sequence number telling whether it is ready to be
+ * written for a given round of the ring or to be read. A producer claims a
+ * position by a compare-and-swap on the enqueue counter, writes the element
+ * and then publishes the cell by bumping its sequence number; consumers do
+ * the same with the dequeue counter. Nothing is allocated after construction.
+ *
+ * Requires GCC's __sync builtins.
+ */
+template <class T> class ConcurrentArrayQueue {
+    private:
+    class Cell {
+        public:
+        volatile unsigned long long seq;
+        T value;
+    };
+
+    Cell *cells;
+    unsigned long long mask;
+    char padCells[64];
+    volatile unsigned long long enqueuePos;
+    char padEnqueue[64 - sizeof(unsigned long long)];
+    volatile unsigned long long dequeuePos;
+    char padDequeue[64 - sizeof(unsigned long long)];
+
+    ConcurrentArrayQueue(const ConcurrentArrayQueue &);
+    ConcurrentArrayQueue& operator = (const ConcurrentArrayQueue &);
+
+    public:
+    static const int DEFAULT_CAPACITY = 1024;
+
+    /**
+     * Constructs an empty queue holding at most capacity elements, rounded
+     * up to a power of two.
+     */
+    ConcurrentArrayQueue(int capacity = DEFAULT_CAPACITY) {
+        unsigned long long cap = 2;
+        while (cap < (unsigned long long)capacity) cap <<= 1;
+        cells = new Cell[cap];
+        for (unsigned long long i = 0; i < cap; ++i) cells[i].seq = i;
+        mask = cap - 1;
+        enqueuePos = dequeuePos = 0;
+    }
+
+    /**
+     * Destructor. No other thread may use the queue any more.
+     */
+    ~ConcurrentArrayQueue() {
+        delete [] cells;
+    }
+
+    /**
+     * Appends the specified element to the end of this queue.
+     * Returns false, leaving the queue unchanged, if it is full.
+     * Lock-free, O(1) without contention.
+     */
+    bool add(const T& elem) {
+        unsigned long long pos = enqueuePos;
+        Cell *cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            long long dif = (long long)cell->seq - (long long)pos;
+            if (dif == 0) {
+                unsigned long long seen = __sync_val_compare_and_swap(&enqueuePos, pos, pos + 1);
+                if (seen == pos) break;
+                pos = seen;
+            }
+            else if (dif < 0) return false;
+            else pos = enqueuePos;
+        }
+        cell->value = elem;
+        __sync_synchronize();
+        cell->seq = pos + 1;
+        return true;
+    }
+
+    /**
+     * Removes the first element into elem if there is one.
+     * Returns false if the queue was empty.
+     * Lock-free, O(1) without contention.
+     */
+    bool poll(T& elem) {
+        unsigned long long pos = dequeuePos;
+        Cell *cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            long long dif = (long long)cell->seq - (long long)(pos + 1);
+            if (dif == 0) {
+                unsigned long long seen = __sync_val_compare_and_swap(&dequeuePos, pos, pos + 1);
+                if (seen == pos) break;
+                pos = seen;
+            }
+            else if (dif < 0) return false;
+            else pos = dequeuePos;
+        }
+        elem = cell->value;
+        __sync_synchronize();
+        cell->seq = pos + mask + 1;
+        return true;
+    }
+
+    /**
+     * Removes and returns the first element from this queue.
+     * Lock-free, O(1) without contention.
+     * @throw ElementNotExist
+     */
+    T removeFirst() {
+        T res;
+        if (!poll(res)) throw ElementNotExist("\nNo Such Element\n");
+        return res;
+    }
+
+    /**
+     * Returns true if this queue contained no elements at the moment of the
+     * call.
+     * O(1)
+     */
+    bool isEmpty() const {
+        unsigned long long pos = dequeuePos;
+        return (long long)cells[pos & mask].seq - (long long)(pos + 1) < 0;
+    }
+
+    /**
+     * Returns the number of elements this queue can hold.
+     * O(1)
+     */
+    int capacity() const {
+        return (int)(mask + 1);
+    }
+};
+
+#endif
@@ -0,0 +1,200 @@
+/** @file */
+#ifndef __CONCURRENTLINKEDQUEUE_H
+#define __CONCURRENTLINKEDQUEUE_H
+
+#include "Utility.h"
+#include<cstddef>
+
+/**
+ * An unbounded lock-free queue for many producers and many consumers, with
+ * the deque methods of LinkedList used by work queues (add, removeFirst,
+ * isEmpty).
+ *
+ * This is the Michael-Scott queue. Memory is reclaimed the way the original
+ * paper does it: links are 32-bit node indices paired with a 32-bit version
+ * tag, so that every compare-and-swap works on one 64-bit word and a node
+ * which is freed and reused in between cannot be mistaken for the old one.
+ * Nodes live in segments which are never returned to the system before the
+ * queue is destroyed, so a thread reading a node that another thread just
+ * dequeued still reads valid memory. Dequeued nodes go to a lock-free free
+ * list and are reused, so the queue stops allocating at its working size.
+ *
+ * A consumer may read a node while it is being recycled, so a node holds
+ * its element through a pointer: the consumer which wins the dequeue is the
+ * only one to follow it, copy the element out and free it. Any copyable T
+ * is therefore safe, at the price of one allocation per element.
+ *
+ * Requires GCC's __sync builtins and a 64-bit compare-and-swap.
+ */
+template <class T> class ConcurrentLinkedQueue {
+    private:
+    static const int FIRST_SEGMENT = 64, SEGMENT_NUM = 26;
+
+    class Node {
+        public:
+        T * volatile value;
+        volatile unsigned long long next;
+        Node(): value(NULL), next(0) {}
+    };
+
+    /**
+     * The shared words live on cache lines of their own.
+     */
+    volatile unsigned long long head;
+    char padHead[64 - sizeof(unsigned long long)];
+    volatile unsigned long long tail;
+    char padTail[64 - sizeof(unsigned long long)];
+    volatile unsigned long long freeTop;
+    char padFree[64 - sizeof(unsigned long long)];
+    volatile unsigned int allocated;
+    Node * volatile segments[SEGMENT_NUM];
+
+    static unsigned long long makeLink(unsigned int index, unsigned int tag) {
+        return ((unsigned long long)tag << 32) | index;
+    }
+
+    static unsigned int indexOf(unsigned long long link) {
+        return (unsigned int)link;
+    }
+
+    static unsigned int tagOf(unsigned long long link) {
+        return (unsigned int)(link >> 32);
+    }
+
+    static bool cas(volatile unsigned long long *word, unsigned long long expected, unsigned long long value) {
+        return __sync_bool_compare_and_swap(word, expected, value);
+    }
+
+    /**
+     * Node indices start from 1; segment s holds FIRST_SEGMENT << s nodes.
+     */
+    Node* node(unsigned int index) const {
+        unsigned int i = index - 1 + FIRST_SEGMENT;
+        int s = 31 - __builtin_clz(i / FIRST_SEGMENT);
+        return segments[s] + (i - (FIRST_SEGMENT << s));
+    }
+
+    unsigned int allocNode() {
+        while (true) {
+            unsigned long long top = freeTop;
+            unsigned int index = indexOf(top);
+            if (index == 0) break;
+            unsigned long long next = node(index)->next;
+            if (cas(&freeTop, top, makeLink(indexOf(next), tagOf(top) + 1)))
+                return index;
+        }
+        unsigned int index = __sync_add_and_fetch(&allocated, 1);
+        unsigned int i = index - 1 + FIRST_SEGMENT;
+        int s = 31 - __builtin_clz(i / FIRST_SEGMENT);
+        if (segments[s] == NULL) {
+            Node *seg = new Node[FIRST_SEGMENT << s];
+            if (!__sync_bool_compare_and_swap(&segments[s], (Node*)NULL, seg))
+                delete [] seg;
+        }
+        return index;
+    }
+
+    void freeNode(unsigned int index) {
+        Node *n = node(index);
+        while (true) {
+            unsigned long long top = freeTop, next = n->next;
+            n->next = makeLink(indexOf(top), tagOf(next) + 1);
+            if (cas(&freeTop, top, makeLink(index, tagOf(top) + 1))) return;
+        }
+    }
+
+    ConcurrentLinkedQueue(const ConcurrentLinkedQueue &);
+    ConcurrentLinkedQueue& operator = (const ConcurrentLinkedQueue &);
+
+    public:
+    /**
+     * Constructs an empty queue
+     */
+    ConcurrentLinkedQueue(): freeTop(0), allocated(0) {
+        for (int i = 0; i < SEGMENT_NUM; ++i) segments[i] = NULL;
+        unsigned int dummy = allocNode();
+        head = tail = makeLink(dummy, 0);
+    }
+
+    /**
+     * Destructor. No other thread may use the queue any more.
+     */
+    ~ConcurrentLinkedQueue() {
+        for (unsigned int i = indexOf(node(indexOf(head))->next); i != 0; i = indexOf(node(i)->next))
+            delete node(i)->value;
+        for (int i = 0; i < SEGMENT_NUM; ++i) delete [] segments[i];
+    }
+
+    /**
+     * Appends the specified element to the end of this queue.
+     * Lock-free, O(1) without contention.
+     * Always returns true;
+     */
+    bool add(const T& elem) {
+        unsigned int index = allocNode();
+        Node *n = node(index);
+        n->value = new T(elem);
+        n->next = makeLink(0, tagOf(n->next) + 1);
+        unsigned long long last;
+        while (true) {
+            last = tail;
+            unsigned long long next = node(indexOf(last))->next;
+            if (last != tail) continue;
+            if (indexOf(next) == 0) {
+                if (cas(&node(indexOf(last))->next, next, makeLink(index, tagOf(next) + 1))) break;
+            }
+            else cas(&tail, last, makeLink(indexOf(next), tagOf(last) + 1));
+        }
+        cas(&tail, last, makeLink(index, tagOf(last) + 1));
+        return true;
+    }
+
+    /**
+     * Removes the first element into elem if there is one.
+     * Returns false if the queue was empty.
+     * Lock-free, O(1) without contention.
+     */
+    bool poll(T& elem) {
+        unsigned long long first;
+        T *value;
+        while (true) {
+            first = head;
+            unsigned long long last = tail, next = node(indexOf(first))->next;
+            if (first != head) continue;
+            if (indexOf(first) == indexOf(last)) {
+                if (indexOf(next) == 0) return false;
+                cas(&tail, last, makeLink(indexOf(next), tagOf(last) + 1));
+            }
+            else {
+                value = node(indexOf(next))->value;
+                if (cas(&head, first, makeLink(indexOf(next), tagOf(first) + 1))) break;
+            }
+        }
+        freeNode(indexOf(first));
+        elem = *value;
+        delete value;
+        return true;
+    }
+
+    /**
+     * Removes and returns the first element from this queue.
+     * Lock-free, O(1) without contention.
+     * @throw ElementNotExist
+     */
+    T removeFirst() {
+        T res;
+        if (!poll(res)) throw ElementNotExist("\nNo Such Element\n");
+        return res;
+    }
+
+    /**
+     * Returns true if this queue contained no elements at the moment of the
+     * call.
+     * O(1)
+     */
+    bool isEmpty() const {
+        return indexOf(node(indexOf(head))->next) == 0;
+    }
+};
+
+#endif
@@ -0,0 +1,644 @@
+/** @file */
+#ifndef __CONCURRENTSKIPLISTMAP_H
+#define __CONCURRENTSKIPLISTMAP_H
+
+#include "Utility.h"
+#include<cstddef>
+#include<new>
+#include<stdint.h>
+
+/**
+ * An ordered map which many threads may read and change at the same time
+ * without a lock, with the method names of TreeMap.
+ *
+ * This is a lock-free skip list. A node holds its value through a pointer
+ * which put replaces with one compare-and-swap, and which remove swaps for
+ * NULL: that is the moment the mapping is gone. The remover then marks the
+ * lowest bit of each of the node's forward links, so that no node can be
+ * linked after it, and the searches that come across a marked node unlink
+ * it, as in Harris' linked list.
+ *
+ * get, containsKey and the iterators only read and never wait. The
+ * iterators are weakly consistent: they never throw because of concurrent
+ * changes, return every mapping present during the whole iteration once in
+ * key order, and may or may not return the mappings changed meanwhile.
+ * size() is the count at one moment, exact only without concurrent writes.
+ *
+ * A removed node or a replaced value may still be read by other threads,
+ * so it is kept on a list instead of being freed at once. Every method and
+ * every live iterator counts as an active user of the map, and the list is
+ * freed only when the map is idle: when the count falls back to zero, by
+ * the thread leaving last, or by an explicit call to reclaim(). There is
+ * no epoch or hazard pointer scheme. While calls overlap, as they usually
+ * do with several threads on several cores, or while an iterator is kept
+ * alive, nothing is freed and the list grows with every removal and
+ * replacement. Long-running users should make the map idle from time to
+ * time, for instance between batches of work.
+ *
+ * Values are returned by copy, since another thread may replace them.
+ * Template argument C is the comparator class, as for TreeMap.
+ *
+ * Requires GCC's __sync builtins.
+ */
+template <class K, class V, class C = Comparator<K> >
+class ConcurrentSkipListMap {
+    private:
+    /**
+     * A node is promoted to each next level with probability 1/4.
+     */
+    static const int MAX_LEVEL = 16;
+
+    class Box {
+        public:
+        const V value;
+        Box *retiredNext;
+        Box(const V& _value): value(_value), retiredNext(NULL) {}
+    };
+
+    class Node {
+        public:
+        const K key;
+        Box * volatile box;
+        Node *retiredNext;
+        int level;
+        /**
+         * level forward links, the node being allocated with room for them.
+         */
+        Node * volatile next[1];
+        Node(const K& _key, Box *_box, int _level): key(_key), box(_box), retiredNext(NULL), level(_level) {}
+    };
+
+    Node *head;
+    volatile int sz;
+    /**
+     * The number of methods in progress plus the number of live iterators.
+     */
+    mutable volatile int active;
+    mutable Node * volatile retiredNodes;
+    mutable Box * volatile retiredBoxes;
+
+    /**
+     * Counts a method as an active user of the map while it runs.
+     */
+    class Guard {
+        const ConcurrentSkipListMap *map;
+        public:
+        Guard(const ConcurrentSkipListMap *_map): map(_map) {
+            map->enter();
+        }
+        ~Guard() {
+            map->leave();
+        }
+    };
+
+    ConcurrentSkipListMap(const ConcurrentSkipListMap &);
+    ConcurrentSkipListMap& operator = (const ConcurrentSkipListMap &);
+
+    static bool isMarked(Node *link) {
+        return (uintptr_t)link & 1;
+    }
+
+    static Node* marked(Node *link) {
+        return (Node*)((uintptr_t)link | 1);
+    }
+
+    static Node* unmarked(Node *link) {
+        return (Node*)((uintptr_t)link & ~(uintptr_t)1);
+    }
+
+    static bool cas(Node * volatile *link, Node *expected, Node *value) {
+        return __sync_bool_compare_and_swap(link, expected, value);
+    }
+
+    static int randomLevel() {
+        static __thread unsigned int seed;
+        if (seed == 0) seed = (unsigned int)(uintptr_t)&seed | 1;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        unsigned int r = seed;
+        int level = 1;
+        while (level < MAX_LEVEL && (r & 3) == 0) {
+            level++;
+            r >>= 2;
+        }
+        return level;
+    }
+
+    static Node* newNode(const K& key, Box *box, int level) {
+        void *mem = ::operator new(sizeof(Node) + (level - 1) * sizeof(Node*));
+        return new (mem) Node(key, box, level);
+    }
+
+    static void freeNode(Node *node) {
+        node->~Node();
+        ::operator delete(node);
+    }
+
+    /**
+     * Pushes the chain from first to last, linked by retiredNext, on list.
+     */
+    template <class T>
+    static void push(T * volatile *list, T *first, T *last) {
+        do last->retiredNext = *list;
+        while (!__sync_bool_compare_and_swap(list, last->retiredNext, first));
+    }
+
+    template <class T>
+    static T* lastOf(T *chain) {
+        while (chain->retiredNext != NULL) chain = chain->retiredNext;
+        return chain;
+    }
+
+    void retire(Node *node) {
+        push(&retiredNodes, node, node);
+    }
+
+    void retire(Box *box) {
+        push(&retiredBoxes, box, box);
+    }
+
+    void enter() const {
+        __sync_fetch_and_add(&active, 1);
+    }
+
+    void leave() const {
+        if (__sync_sub_and_fetch(&active, 1) == 0 && (retiredNodes != NULL || retiredBoxes != NULL))
+            tryReclaim();
+    }
+
+    /**
+     * Takes the retired nodes and values, then frees them if nobody uses
+     * the map: a thread coming later cannot reach them any more, since
+     * they were unlinked before being retired. Otherwise puts them back.
+     */
+    void tryReclaim() const {
+        Node *nodes = __sync_lock_test_and_set(&retiredNodes, (Node*)NULL);
+        Box *boxes = __sync_lock_test_and_set(&retiredBoxes, (Box*)NULL);
+        if (__sync_fetch_and_add(&active, 0) != 0) {
+            if (nodes != NULL) push(&retiredNodes, nodes, lastOf(nodes));
+            if (boxes != NULL) push(&retiredBoxes, boxes, lastOf(boxes));
+            return;
+        }
+        freeRetired(nodes, boxes);
+    }
+
+    static void freeRetired(Node *nodes, Box *boxes) {
+        while (nodes != NULL) {
+            Node *next = nodes->retiredNext;
+            freeNode(nodes);
+            nodes = next;
+        }
+        while (boxes != NULL) {
+            Box *next = boxes->retiredNext;
+            delete boxes;
+            boxes = next;
+        }
+    }
+
+    /**
+     * Marks every forward link of node, top level first, so that nothing
+     * can be linked after it any more.
+     */
+    static void markLinks(Node *node) {
+        for (int i = node->level - 1; i >= 0; --i) {
+            while (true) {
+                Node *succ = node->next[i];
+                if (isMarked(succ) || cas(&node->next[i], succ, marked(succ))) break;
+            }
+        }
+    }
+
+    /**
+     * Fills preds and succs with the last node whose key is less than key
+     * and the node after it, on every level, unlinking on the way the marked
+     * nodes. Returns the node of key on the lowest level, or NULL.
+     */
+    template <class K2>
+    Node* find(const K2& key, Node **preds, Node **succs) const {
+        retry:
+        Node *pred = head;
+        for (int i = MAX_LEVEL - 1; i >= 0; --i) {
+            Node *curr = unmarked(pred->next[i]);
+            while (curr != NULL) {
+                Node *succ = curr->next[i];
+                if (isMarked(succ)) {
+                    if (!cas(&pred->next[i], curr, unmarked(succ))) goto retry;
+                    curr = unmarked(succ);
+                    continue;
+                }
+                if (C::compare(key, curr->key) <= 0) break;
+                pred = curr;
+                curr = succ;
+            }
+            preds[i] = pred;
+            succs[i] = curr;
+        }
+        Node *res = succs[0];
+        return res != NULL && C::compare(key, res->key) == 0 ? res : NULL;
+    }
+
+    /**
+     * Returns the first node whose key is not less than key (greater than
+     * key if strict), without changing anything. It may have been removed.
+     */
+    template <class K2>
+    Node* seek(const K2& key, bool strict) const {
+        Node *pred = head, *curr = NULL;
+        for (int i = MAX_LEVEL - 1; i >= 0; --i) {
+            curr = unmarked(pred->next[i]);
+            while (curr != NULL) {
+                int c = C::compare(key, curr->key);
+                if (c < 0 || (c == 0 && !strict)) break;
+                pred = curr;
+                curr = unmarked(curr->next[i]);
+            }
+        }
+        return curr;
+    }
+
+    template <class K2>
+    Box* getBox(const K2& key) const {
+        Node *node = seek(key, false);
+        if (node == NULL || C::compare(key, node->key) != 0) return NULL;
+        return node->box;
+    }
+
+    public:
+    /**
+     * An iterator counts as an active user of the map from its creation to
+     * its destruction, so that the nodes it reaches are not freed.
+     */
+    class ConstIterator {
+        private:
+        const ConcurrentSkipListMap *map;
+        Node *nxt;
+        Box *nxtBox;
+        bool hasHi;
+        K hi;
+
+        void use(const ConcurrentSkipListMap *_map) {
+            if (_map != NULL) _map->enter();
+            if (map != NULL) map->leave();
+            map = _map;
+        }
+
+        /**
+         * Moves to the first node from node on which is still mapped.
+         */
+        void seekLive(Node *node) {
+            for (; node != NULL; node = unmarked(node->next[0])) {
+                if (hasHi && C::compare(node->key, hi) >= 0) break;
+                nxtBox = node->box;
+                if (nxtBox != NULL) {
+                    nxt = node;
+                    return;
+                }
+            }
+            nxt = NULL;
+        }
+
+        public:
+        ConstIterator(): map(NULL), nxt(NULL), hasHi(false) {}
+
+        explicit ConstIterator(const ConcurrentSkipListMap *_map): map(NULL), nxt(NULL), hasHi(false) {
+            use(_map);
+        }
+
+        ConstIterator(const ConstIterator &x): map(NULL), nxt(x.nxt), nxtBox(x.nxtBox), hasHi(x.hasHi), hi(x.hi) {
+            use(x.map);
+        }
+
+        ConstIterator& operator = (const ConstIterator &x) {
+            use(x.map);
+            nxt = x.nxt; nxtBox = x.nxtBox; hasHi = x.hasHi; hi = x.hi;
+            return *this;
+        }
+
+        ~ConstIterator() {
+            use(NULL);
+        }
+
+        /**
+         * Starts at node and stops before the key _hi if _hasHi. node must
+         * have been read after the iterator was constructed for the map.
+         */
+        void init(Node *node, bool _hasHi, const K& _hi) {
+            hasHi = _hasHi;
+            hi = _hi;
+            seekLive(node);
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1).
+         */
+        bool hasNext() {
+            return nxt != NULL;
+        }
+
+        /**
+         * Returns a copy of the next element in the iteration.
+         * O(1) without concurrent removals.
+         * @throw ElementNotExist
+         */
+        Entry<K, V> next() {
+            if (nxt == NULL) throw ElementNotExist("\nNo Such Element\n");
+            Entry<K, V> res(nxt->key, nxtBox->value);
+            seekLive(unmarked(nxt->next[0]));
+            return res;
+        }
+    };
+
+    /**
+     * A view of the mappings whose keys lie from lo, inclusive, to hi,
+     * exclusive, reflecting the later changes of the map.
+     */
+    class SubMap {
+        public:
+        typedef typename ConcurrentSkipListMap<K, V, C>::ConstIterator ConstIterator;
+        private:
+        const ConcurrentSkipListMap *map;
+        K lo, hi;
+        public:
+        SubMap(const ConcurrentSkipListMap *_map, const K& _lo, const K& _hi): map(_map), lo(_lo), hi(_hi) {}
+
+        /**
+         * Returns an const iterator over the mappings of the range.
+         * O(logn) expected.
+         */
+        ConstIterator constIterator() const {
+            ConstIterator CItr(map);
+            CItr.init(map->seek(lo, false), true, hi);
+            return CItr;
+        }
+
+        /**
+         * Returns true if the range holds a mapping for the specified key.
+         * O(logn) expected.
+         */
+        bool containsKey(const K& key) const {
+            return C::compare(key, lo) >= 0 && C::compare(key, hi) < 0 && map->containsKey(key);
+        }
+
+        /**
+         * Returns true if no mapping lies in the range.
+         * O(logn) expected.
+         */
+        bool isEmpty() const {
+            return !constIterator().hasNext();
+        }
+
+        /**
+         * Returns the number of mappings in the range.
+         * O(logn + m) expected, m being the size of the range.
+         */
+        int size() const {
+            int cnt = 0;
+            for (ConstIterator it = constIterator(); it.hasNext(); it.next())
+                cnt++;
+            return cnt;
+        }
+    };
+
+    /**
+     * Constructs an empty map
+     */
+    ConcurrentSkipListMap(): sz(0), active(0), retiredNodes(NULL), retiredBoxes(NULL) {
+        head = newNode(K(), NULL, MAX_LEVEL);
+        for (int i = 0; i < MAX_LEVEL; ++i) head->next[i] = NULL;
+    }
+
+    /**
+     * Constructs a map containing the same mappings as the given map.
+     */
+    template <class M>
+    explicit ConcurrentSkipListMap(const M& m): sz(0), active(0), retiredNodes(NULL), retiredBoxes(NULL) {
+        head = newNode(K(), NULL, MAX_LEVEL);
+        for (int i = 0; i < MAX_LEVEL; ++i) head->next[i] = NULL;
+        addAll(*this, m);
+    }
+
+    /**
+     * Destructor, also freeing the removed nodes and the replaced values.
+     * No other thread may use the map any more.
+     */
+    ~ConcurrentSkipListMap() {
+        Node *node = unmarked(head->next[0]);
+        while (node != NULL) {
+            Node *next = unmarked(node->next[0]);
+            if (node->box != NULL) {
+                delete node->box;
+                freeNode(node);
+            }
+            node = next;
+        }
+        freeNode(head);
+        freeRetired(retiredNodes, retiredBoxes);
+    }
+
+    /**
+     * Frees the removed nodes and the replaced values if no method is in
+     * progress and no iterator is alive, and otherwise leaves them to the
+     * last user leaving. The last user already does this, but a thread
+     * entering at that very moment makes it give up, so a map which stays
+     * idle afterwards may keep them until this is called.
+     * O(r), r being the number of nodes and values retired since the last
+     * reclamation.
+     */
+    void reclaim() {
+        if (retiredNodes != NULL || retiredBoxes != NULL) tryReclaim();
+    }
+
+    /**
+     * Returns an const iterator over the mappings in key order.
+     * O(1).
+     */
+    ConstIterator constIterator() const {
+        ConstIterator CItr(this);
+        CItr.init(unmarked(head->next[0]), false, K());
+        return CItr;
+    }
+
+    /**
+     * Returns an const iterator starting at the first mapping whose key is
+     * not less than key.
+     * O(logn) expected.
+     */
+    ConstIterator lowerBound(const K& key) const {
+        ConstIterator CItr(this);
+        CItr.init(seek(key, false), false, key);
+        return CItr;
+    }
+
+    /**
+     * Returns an const iterator starting at the first mapping whose key is
+     * greater than key.
+     * O(logn) expected.
+     */
+    ConstIterator upperBound(const K& key) const {
+        ConstIterator CItr(this);
+        CItr.init(seek(key, true), false, key);
+        return CItr;
+    }
+
+    /**
+     * Returns a view of the mappings whose keys lie from lo, inclusive, to
+     * hi, exclusive.
+     * O(1).
+     */
+    SubMap subMap(const K& lo, const K& hi) const {
+        return SubMap(this, lo, hi);
+    }
+
+    /**
+     * Returns true if this map contains a mapping for the specified key.
+     * Wait-free, O(logn) expected.
+     */
+    template <class K2>
+    bool containsKey(const K2& key) const {
+        Guard guard(this);
+        return getBox(key) != NULL;
+    }
+
+    /**
+     * Returns a copy of the value to which the specified key is mapped.
+     * Wait-free, O(logn) expected.
+     * @throw ElementNotExist
+     */
+    template <class K2>
+    V get(const K2& key) const {
+        Guard guard(this);
+        Box *box = getBox(key);
+        if (box == NULL) throw ElementNotExist("\nNo Such Element\n");
+        return box->value;
+    }
+
+    /**
+     * Returns a copy of the first (lowest) key currently in this map.
+     * O(1) without concurrent removals.
+     * @throw ElementNotExist
+     */
+    K firstKey() const {
+        Guard guard(this);
+        for (Node *node = unmarked(head->next[0]); node != NULL; node = unmarked(node->next[0]))
+            if (node->box != NULL) return node->key;
+        throw ElementNotExist("\nNo Such Element\n");
+    }
+
+    /**
+     * Returns a copy of the last (highest) key currently in this map.
+     * O(logn) expected without concurrent removals, O(n) if the last node
+     * is being removed.
+     * @throw ElementNotExist
+     */
+    K lastKey() const {
+        Guard guard(this);
+        Node *pred = head;
+        for (int i = MAX_LEVEL - 1; i >= 0; --i)
+            for (Node *curr = unmarked(pred->next[i]); curr != NULL; curr = unmarked(curr->next[i]))
+                pred = curr;
+        if (pred != head && pred->box != NULL) return pred->key;
+        Node *last = NULL;
+        for (Node *node = unmarked(head->next[0]); node != NULL; node = unmarked(node->next[0]))
+            if (node->box != NULL) last = node;
+        if (last == NULL) throw ElementNotExist("\nNo Such Element\n");
+        return last->key;
+    }
+
+    /**
+     * Returns true if this map contained no mapping at the moment of the
+     * call.
+     * O(1) without concurrent removals.
+     */
+    bool isEmpty() const {
+        return constIterator().hasNext() == false;
+    }
+
+    void add(const Entry<K, V>& e) {
+        put(e.key, e.value);
+    }
+
+    /**
+     * Associates the specified value with the specified key in this map.
+     * Returns the previous value, if not exist, a value returned by the
+     * default-constructor.
+     * Lock-free, O(logn) expected.
+     */
+    V put(const K& key, const V& value) {
+        Guard guard(this);
+        Node *preds[MAX_LEVEL], *succs[MAX_LEVEL];
+        Box *box = new Box(value);
+        Node *node = NULL;
+        while (true) {
+            Node *found = find(key, preds, succs);
+            if (found != NULL) {
+                Box *old = found->box;
+                if (old == NULL) {
+                    markLinks(found);
+                    continue;
+                }
+                if (!__sync_bool_compare_and_swap(&found->box, old, box)) continue;
+                if (node != NULL) freeNode(node);
+                V res = old->value;
+                retire(old);
+                return res;
+            }
+            if (node == NULL) node = newNode(key, box, randomLevel());
+            for (int i = 0; i < node->level; ++i) node->next[i] = succs[i];
+            if (cas(&preds[0]->next[0], succs[0], node)) break;
+        }
+        __sync_fetch_and_add(&sz, 1);
+        for (int i = 1; i < node->level; ++i) {
+            while (true) {
+                Node *succ = node->next[i];
+                if (isMarked(succ)) return V();
+                if (succ != succs[i] && !cas(&node->next[i], succ, succs[i])) continue;
+                if (cas(&preds[i]->next[i], succs[i], node)) {
+                    if (isMarked(node->next[i])) {
+                        find(key, preds, succs);
+                        return V();
+                    }
+                    break;
+                }
+                if (find(key, preds, succs) != node) return V();
+            }
+        }
+        return V();
+    }
+
+    /**
+     * Removes the mapping for the specified key from this map if present.
+     * Returns the removed value.
+     * Lock-free, O(logn) expected.
+     * @throw ElementNotExist
+     */
+    template <class K2>
+    V remove(const K2& key) {
+        Guard guard(this);
+        Node *preds[MAX_LEVEL], *succs[MAX_LEVEL];
+        Node *node = find(key, preds, succs);
+        Box *box;
+        do {
+            if (node == NULL || (box = node->box) == NULL)
+                throw ElementNotExist("\nNo Such Element\n");
+        } while (!__sync_bool_compare_and_swap(&node->box, box, (Box*)NULL));
+        __sync_fetch_and_sub(&sz, 1);
+        markLinks(node);
+        find(key, preds, succs);
+        V res = box->value;
+        retire(box);
+        retire(node);
+        return res;
+    }
+
+    /**
+     * Returns the number of key-value mappings in this map.
+     * O(1).
+     */
+    int size() const {
+        return sz;
+    }
+};
+
+#endif
@@ -0,0 +1,128 @@
+/** @file */
+#ifndef __FILTEREDHASHSET_H
+#define __FILTEREDHASHSET_H
+
+#include "Utility.h"
+#include "HashSet.h"
+#include "BloomFilter.h"
+
+/**
+ * A HashSet with a BloomFilter in front of it.
+ *
+ * contains() asks the small filter first and only probes the hash table
+ * when the filter answers ``maybe'', so lookups of absent elements in a set
+ * too large for the cache rarely touch the table at all.
+ *
+ * A Bloom filter cannot forget an element, so removed elements stay in the
+ * filter and only cost a useless probe. The filter is rebuilt from the set
+ * when the set outgrows it or when the removed elements outnumber the
+ * present ones.
+ *
+ * Template argument H is the hash class, as for HashSet.
+ */
+template <class T, class H> class FilteredHashSet {
+    private:
+    HashSet<T, H> set;
+    BloomFilter<T, H> filter;
+    int bitsPerElem, removed;
+
+    void rebuild() {
+        int expected = set.size() * 2;
+        if (expected < 1024) expected = 1024;
+        filter = BloomFilter<T, H>(expected, bitsPerElem);
+        addAll(filter, set);
+        removed = 0;
+    }
+
+    public:
+    typedef typename HashSet<T, H>::ConstIterator ConstIterator;
+    typedef typename HashSet<T, H>::Iterator Iterator;
+
+    /**
+     * Constructs an empty set. The filter spends bitsPerElement bits on each
+     * element, trading memory against the rate of useless table probes.
+     */
+    FilteredHashSet(int bitsPerElement = BloomFilter<T, H>::DEFAULT_BITS_PER_ELEMENT):
+        filter(1024, bitsPerElement), bitsPerElem(bitsPerElement), removed(0) {}
+
+    /**
+     * Constructs a new set containing the elements in the specified
+     * collection.
+     */
+    template<class C> explicit FilteredHashSet(const C& c):
+        set(c), bitsPerElem(BloomFilter<T, H>::DEFAULT_BITS_PER_ELEMENT) {
+        rebuild();
+    }
+
+    /**
+     * Adds the specified element to this set if it is not already present.
+     * Returns false if element is previously in the set.
+     * O(1) for average
+     */
+    bool add(const T& elem) {
+        if (!set.add(elem)) return false;
+        if (set.size() > filter.capacity()) rebuild();
+        else filter.add(elem);
+        return true;
+    }
+
+    /**
+     * Removes all of the elements from this set.
+     */
+    void clear() {
+        set.clear();
+        filter.clear();
+        removed = 0;
+    }
+
+    /**
+     * Returns true if this set contains the specified element.
+     * O(1), and the hash table is probed only if the filter lets it through.
+     */
+    bool contains(const T& elem) const {
+        return filter.mightContain(elem) && set.contains(elem);
+    }
+
+    /**
+     * Returns true if this set contains no elements.
+     * O(1)
+     */
+    bool isEmpty() const {
+        return set.isEmpty();
+    }
+
+    /**
+     * Returns an iterator over the elements in this set.
+     * Elements removed through it stay in the filter until its next rebuild.
+     */
+    Iterator iterator() {
+        return set.iterator();
+    }
+
+    /**
+     * Returns an const iterator over the elements in this set.
+     */
+    ConstIterator constIterator() const {
+        return set.constIterator();
+    }
+
+    /**
+     * Removes the specified element from this set if it is present.
+     * O(1) for average, amortized over the filter rebuilds.
+     */
+    bool remove(const T& elem) {
+        if (!set.remove(elem)) return false;
+        if (++removed > set.size() && removed > 1024) rebuild();
+        return true;
+    }
+
+    /**
+     * Returns the number of elements in this set (its cardinality).
+     * O(1)
+     */
+    int size() const {
+        return set.size();
+    }
+};
+
+#endif
@@ -3,13 +3,19 @@
 #define __HASHSET_H
 
 #include "Utility.h"
-#include "HashMap.h"
+#include<cstdlib>
+#include<cstring>
+#include<pthread.h>
 
 /**
  * A HashSet holds elements using a hash table, providing facilities
  * to insert, remove an element into the container and search an
  * element within the container efficiently.
  *
+ * The table is a chained hash table of its own which stores only the keys,
+ * so there is neither a value slot per element nor an indirection through
+ * a backing map.
+ *
  * We don't require an order in the iteration, but you should
  * guarantee all elements will be iterated.
  *
@@ -31,64 +37,235 @@
  * @endcode
  */
 template <class T, class H> class HashSet {
+    public:
+    static const int DEFAULT_CAPCITY = 11;
+    static const double DEFAULT_LOAD_FACTOR = 0.75;
+    static const int PARALLEL_THRESHOLD = 1 << 16;
     private:
-    HashMap<T, bool, H>* map;
+    class HashNode {
+        public:
+        T key;
+        HashNode *next;
+        HashNode(const T& _key, HashNode *_next): key(_key), next(_next) {}
+    };
+    int threshold, cap;
+    double loadFactor;
+    HashNode **buckets;
+    int sz;
 
-    int getMax(int a, int b) {
+    static int getMax(int a, int b) {
         if (a > b) return a;
         return b;
     }
 
+    int hash(const T &key) const {
+        return abs(H::hashcode(key) % cap);
+    }
+
+    void rehash() {
+        rehash(cap * 2 + 1);
+    }
+
+    void rehash(int newCap) {
+        HashNode **oldBuckets = buckets;
+        int oldCap = cap;
+        cap = newCap;
+        threshold = (int)(cap * loadFactor);
+        buckets = new HashNode*[cap];
+        for (int i = 0; i < cap; ++i) buckets[i] = NULL;
+        for (int i = oldCap - 1; i >= 0; --i) {
+            HashNode *e = oldBuckets[i];
+            while (e != NULL) {
+                int idx = hash(e->key);
+                HashNode *nxt = e->next;
+                e->next = buckets[idx];
+                buckets[idx] = e;
+                e = nxt;
+            }
+        }
+        delete [] oldBuckets;
+    }
+
+    void getSpace() {
+        for (int i = 0; i < cap; ++i) {
+            HashNode *e = buckets[i], *nxt;
+            while (e != NULL) {
+                nxt = e->next;
+                delete e;
+                e = nxt;
+            }
+        }
+    }
+
+    /**
+     * Inserts an element known to be absent, skipping the duplicate probe.
+     */
+    void addUnique(const T& elem) {
+        if (++sz > threshold) rehash();
+        int idx = hash(elem);
+        buckets[idx] = new HashNode(elem, buckets[idx]);
+    }
+
+    void addAllUnique(const HashSet &c) {
+        for (int i = c.cap - 1; i >= 0; --i)
+            for (HashNode *e = c.buckets[i]; e != NULL; e = e->next)
+                addUnique(e->key);
+    }
+
+    /**
+     * Work of one thread in the parallel filters: collects the keys of
+     * buckets [from, to) of src whose membership in other equals keep.
+     */
+    class FilterTask {
+        public:
+        const HashSet *src, *other;
+        int from, to, cnt, len;
+        bool keep;
+        const T **found;
+        /**
+         * Whether a thread was started for the task and must be joined.
+         */
+        bool started;
+        FilterTask(): cnt(0), found(NULL), started(false) {}
+        ~FilterTask() { delete [] found; }
+    };
+
+    static void* filterWorker(void *arg) {
+        FilterTask *task = (FilterTask*)arg;
+        task->cnt = 0; task->len = 16;
+        task->found = new const T*[task->len];
+        for (int i = task->from; i < task->to; ++i)
+            for (HashNode *e = task->src->buckets[i]; e != NULL; e = e->next) {
+                if (task->other->contains(e->key) != task->keep) continue;
+                if (task->cnt == task->len) {
+                    const T **more = new const T*[task->len *= 2];
+                    memcpy(more, task->found, task->cnt * sizeof(const T*));
+                    delete [] task->found;
+                    task->found = more;
+                }
+                task->found[task->cnt++] = &e->key;
+            }
+        return NULL;
+    }
+
+    /**
+     * Splits the buckets of src among threadNum threads and collects the
+     * elements whose membership in other equals keep into res.
+     */
+    static void parallelFilter(const HashSet &src, const HashSet &other, bool keep, int threadNum, HashSet &res) {
+        FilterTask *tasks = new FilterTask[threadNum];
+        pthread_t *threads = new pthread_t[threadNum];
+        int step = (src.cap + threadNum - 1) / threadNum;
+        for (int i = 0; i < threadNum; ++i) {
+            tasks[i].src = &src; tasks[i].other = &other; tasks[i].keep = keep;
+            tasks[i].from = i * step < src.cap ? i * step : src.cap;
+            tasks[i].to = (i + 1) * step < src.cap ? (i + 1) * step : src.cap;
+        }
+        for (int i = 1; i < threadNum; ++i)
+            tasks[i].started = pthread_create(&threads[i], NULL, filterWorker, &tasks[i]) == 0;
+        filterWorker(&tasks[0]);
+        for (int i = 1; i < threadNum; ++i) {
+            if (tasks[i].started) pthread_join(threads[i], NULL);
+            else filterWorker(&tasks[i]);
+        }
+        for (int i = 0; i < threadNum; ++i)
+            for (int j = 0; j < tasks[i].cnt; ++j)
+                res.addUnique(*tasks[i].found[j]);
+        delete [] threads;
+        delete [] tasks;
+    }
+
+    void init(int iniCap, double loadFac) {
+        if (iniCap == 0) iniCap = 1;
+        cap = iniCap;
+        buckets = new HashNode*[iniCap];
+        loadFactor = loadFac;
+        threshold = (int)(iniCap * loadFac);
+        for (int i = 0; i < cap; ++i) buckets[i] = NULL;
+        sz = 0;
+    }
+
     public:
     class ConstIterator {
+        private:
+        int cnt, idx;
+        HashNode *nxt;
+        const HashSet *hashS;
+
         public:
-        typename HashMap<T, bool, H>::ConstIterator mCItr;
+        void init(const HashSet *_hashS, int _cnt, int _idx) {
+            hashS = _hashS; cnt = _cnt; idx = _idx;
+            nxt = NULL;
+        }
+
         /**
          * Returns true if the iteration has more elements.
-         * O(n) for iterating through the container
+         * O(n) for iterating through the container
          */
         bool hasNext() {
-            return mCItr.hasNext();
+            return cnt > 0;
         }
-
+
         /**
          * Returns the next element in the iteration.
-         * O(n) for iterating through the container.
+         * O(n) for iterating through the container.
          * @throw ElementNotExist
          */
         const T& next() {
-            return mCItr.next().key;
+            if (cnt == 0) throw ElementNotExist("\nNo Such Element\n");
+            cnt--;
+            HashNode *e = nxt;
+            while (e == NULL) e = hashS->buckets[--idx];
+            nxt = e->next;
+            return e->key;
         }
     };
 
     class Iterator {
+        private:
+        int cnt, idx;
+        HashNode *last, *nxt;
+        HashSet *hashS;
+
         public:
-        typename HashMap<T, bool, H>::Iterator mItr;
+        void init(HashSet *_hashS, int _cnt, int _idx) {
+            hashS = _hashS; cnt = _cnt; idx = _idx;
+            last = nxt = NULL;
+        }
+
         /**
          * Returns true if the iteration has more elements.
-         * O(n) for iterating through the container.
+         * O(n) for iterating through the container.
          */
         bool hasNext() {
-            return mItr.hasNext();
+            return cnt > 0;
         }
 
         /**
          * Returns the next element in the iteration.
-         * O(n) for iterating through the container
+         * O(n) for iterating through the container
          * @throw ElementNotExist
          */
         const T& next() {
-            return mItr.next().key;
+            if (cnt == 0) throw ElementNotExist("\nNo Such Element\n");
+            cnt--;
+            HashNode *e = nxt;
+            while (e == NULL) e = hashS->buckets[--idx];
+            nxt = e->next;
+            last = e;
+            return e->key;
         }
 
         /**
          * Removes from the underlying collection the last element
          * returned by the iterator.
-         * O(1)
+         * O(1)
          * @throw ElementNotExist
          */
         void remove() {
-            mItr.remove();
+            if (last == NULL) throw ElementNotExist("\nIllegal State\n");
+            hashS->remove(last->key);
+            last = NULL;
         }
     };
 
@@ -96,21 +273,22 @@ template <class T, class H> class HashSet {
      * Constructs a empty set with your own default capacity
      */
     HashSet() {
-        map = new HashMap<T, bool, H>;
+        init(DEFAULT_CAPCITY, DEFAULT_LOAD_FACTOR);
     }
 
     /**
      * Destructor
      */
-    ~HashSet() { 
-        delete map;
+    ~HashSet() {
+        getSpace();
+        delete [] buckets;
     }
 
     /**
      * Copy constructor
      */
     HashSet(const HashSet &c) {
-        map = new HashMap<T, bool, H>(getMax(2 * c.size(), HashMap<T, bool, H>::DEFAULT_CAPCITY));
+        init(getMax(2 * c.size(), DEFAULT_CAPCITY), DEFAULT_LOAD_FACTOR);
         addAll(*this, c);
     }
 
@@ -118,7 +296,9 @@ template <class T, class H> class HashSet {
      * Assignment operator
      */
     HashSet& operator = (const HashSet &c) {
-        *map = *(c.map);
+        if (this == &c) return *this;
+        clear();
+        addAll(*this, c);
         return *this;
     }
 
@@ -127,26 +307,32 @@ template <class T, class H> class HashSet {
      * collection.
      */
     template<class C> explicit HashSet(const C& c) {
-        map = new HashMap<T, bool, H>(getMax(2 * c.size(), HashMap<T, bool, H>::DEFAULT_CAPCITY));
+        init(getMax(2 * c.size(), DEFAULT_CAPCITY), DEFAULT_LOAD_FACTOR);
         addAll(*this, c);
     }
 
     /**
-     * Constructs a new, empty set; the backing HashMap instance has the
-     * specified capacity
+     * Constructs a new, empty set; the hash table has the specified
+     * number of buckets
      */
     HashSet(int capacity) {
-        map = new HashMap<T, bool, H>(capacity);
+        init(capacity, DEFAULT_LOAD_FACTOR);
     }
 
     /**
      * Adds the specified element to this set if it is not already present.
      * Returns false if element is previously in the set.
-     * O(1) for average
+     * O(1) for average
      */
     bool add(const T& elem) {
-        if (map->containsKey(elem)) return false;
-        map->put(elem, true);
+        int idx = hash(elem);
+        for (HashNode *e = buckets[idx]; e != NULL; e = e->next)
+            if (elem == e->key) return false;
+        if (++sz > threshold) {
+            rehash();
+            idx = hash(elem);
+        }
+        buckets[idx] = new HashNode(elem, buckets[idx]);
         return true;
     }
 
@@ -154,23 +340,27 @@ template <class T, class H> class HashSet {
      * Removes all of the elements from this set.
      */
     void clear() {
-        map->clear();
+        getSpace();
+        for (int i = 0; i < cap; ++i) buckets[i] = NULL;
+        sz = 0;
     }
 
     /**
      * Returns true if this set contains the specified element.
-     * O(1) for average
+     * O(1) for average
      */
     bool contains(const T& elem) const {
-        return map->containsKey(elem);
+        for (HashNode *e = buckets[hash(elem)]; e != NULL; e = e->next)
+            if (elem == e->key) return true;
+        return false;
     }
 
     /**
      * Returns true if this set contains no elements.
-     * O(1)
+     * O(1)
      */
     bool isEmpty() const {
-        return map->isEmpty();
+        return sz == 0;
     }
 
     /**
@@ -178,7 +368,7 @@ template <class T, class H> class HashSet {
      */
     Iterator iterator() {
         Iterator Itr;
-        Itr.mItr = map->iterator();
+        Itr.init(this, sz, cap);
         return Itr;
     }
 
@@ -187,26 +377,139 @@ template <class T, class H> class HashSet {
      */
     ConstIterator constIterator() const {
         ConstIterator CItr;
-        CItr.mCItr = map->constIterator();
+        CItr.init(this, sz, cap);
         return CItr;
     }
 
     /**
      * Removes the specified element from this set if it is present.
-     * O(1) for average
+     * O(1) for average
      */
     bool remove(const T& elem) {
-        if (!map->containsKey(elem)) return false;
-        map->remove(elem);
-        return true;
+        int idx = hash(elem);
+        HashNode *e = buckets[idx], *last = NULL;
+        while (e != NULL) {
+            if (elem == e->key) {
+                if (last == NULL) buckets[idx] = e->next;
+                else last->next = e->next;
+                sz--;
+                delete e;
+                return true;
+            }
+            last = e;
+            e = e->next;
+        }
+        return false;
     }
 
     /**
      * Returns the number of elements in this set (its cardinality).
-     * O(1)
+     * O(1)
      */
     int size() const {
-        return map->size();
+        return sz;
+    }
+
+    /**
+     * Enlarges the hash table, if necessary, so that it can hold at least
+     * minSize elements without rehashing.
+     * O(n)
+     */
+    void ensureCapacity(int minSize) {
+        if (minSize > threshold)
+            rehash(getMax((int)(minSize / loadFactor) + 1, cap * 2 + 1));
+    }
+
+    /**
+     * Returns a new set containing the elements in either this set or c.
+     * The larger set is copied without duplicate checks and the smaller
+     * one is merged into it.
+     * O(n + m) for average
+     */
+    HashSet unionWith(const HashSet &c) const {
+        const HashSet &big = sz >= c.sz ? *this : c, &small = sz >= c.sz ? c : *this;
+        HashSet res(getMax((int)((big.sz + small.sz) / loadFactor) + 1, DEFAULT_CAPCITY));
+        res.addAllUnique(big);
+        for (int i = small.cap - 1; i >= 0; --i)
+            for (HashNode *e = small.buckets[i]; e != NULL; e = e->next)
+                if (!big.contains(e->key)) res.addUnique(e->key);
+        return res;
+    }
+
+    /**
+     * Returns a new set containing the elements in both this set and c.
+     * Only the smaller set is iterated.
+     * O(min(n, m)) for average
+     */
+    HashSet intersectWith(const HashSet &c) const {
+        const HashSet &big = sz >= c.sz ? *this : c, &small = sz >= c.sz ? c : *this;
+        HashSet res(getMax((int)(small.sz / loadFactor) + 1, DEFAULT_CAPCITY));
+        for (int i = small.cap - 1; i >= 0; --i)
+            for (HashNode *e = small.buckets[i]; e != NULL; e = e->next)
+                if (big.contains(e->key)) res.addUnique(e->key);
+        return res;
+    }
+
+    /**
+     * Returns a new set containing the elements in this set but not in c.
+     * If c is the smaller one, this set is copied and the elements of c
+     * are taken out, so c is the one being probed at most once per element.
+     * O(min(n, m)) probes for average, plus O(n) for the copy
+     */
+    HashSet differenceWith(const HashSet &c) const {
+        HashSet res(getMax((int)(sz / loadFactor) + 1, DEFAULT_CAPCITY));
+        if (sz <= c.sz) {
+            for (int i = cap - 1; i >= 0; --i)
+                for (HashNode *e = buckets[i]; e != NULL; e = e->next)
+                    if (!c.contains(e->key)) res.addUnique(e->key);
+        }
+        else {
+            res.addAllUnique(*this);
+            for (int i = c.cap - 1; i >= 0; --i)
+                for (HashNode *e = c.buckets[i]; e != NULL; e = e->next)
+                    res.remove(e->key);
+        }
+        return res;
+    }
+
+    /**
+     * Returns true if this set and c have no element in common.
+     * Only the smaller set is iterated.
+     * O(min(n, m)) for average
+     */
+    bool isDisjoint(const HashSet &c) const {
+        const HashSet &big = sz >= c.sz ? *this : c, &small = sz >= c.sz ? c : *this;
+        for (int i = small.cap - 1; i >= 0; --i)
+            for (HashNode *e = small.buckets[i]; e != NULL; e = e->next)
+                if (big.contains(e->key)) return false;
+        return true;
+    }
+
+    /**
+     * Same as intersectWith, but the buckets of the smaller set are probed
+     * by threadNum threads. Small sets are handled by intersectWith.
+     * The hash function must be safe to call from several threads.
+     * O(min(n, m) / threadNum) for average
+     */
+    HashSet parallelIntersectWith(const HashSet &c, int threadNum = 4) const {
+        const HashSet &big = sz >= c.sz ? *this : c, &small = sz >= c.sz ? c : *this;
+        if (threadNum <= 1 || small.sz < PARALLEL_THRESHOLD) return intersectWith(c);
+        HashSet res(getMax((int)(small.sz / loadFactor) + 1, DEFAULT_CAPCITY));
+        parallelFilter(small, big, true, threadNum, res);
+        return res;
+    }
+
+    /**
+     * Same as differenceWith, but the buckets of this set are probed by
+     * threadNum threads. Small sets are handled by differenceWith.
+     * The hash function must be safe to call from several threads.
+     * O(n / threadNum) for average
+     */
+    HashSet parallelDifferenceWith(const HashSet &c, int threadNum = 4) const {
+        if (threadNum <= 1 || sz < PARALLEL_THRESHOLD) return differenceWith(c);
+        HashSet res(getMax((int)(sz / loadFactor) + 1, DEFAULT_CAPCITY));
+        parallelFilter(*this, c, false, threadNum, res);
+        return res;
     }
 };
 
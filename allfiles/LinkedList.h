@@ -4,10 +4,17 @@
 
 #include "Utility.h"
 #include<cstdio>
+#include<limits>
 
 /**
  * A linked list.
  *
+ * Removed nodes are kept in a per-list pool and reused by later insertions,
+ * so a list used as a queue stops allocating once it reaches its working
+ * size. The element of a pooled node is reset to T(), so it holds no
+ * resources, but the list keeps the memory of its peak size, clear()
+ * included, until trimToSize() gives the pooled nodes back.
+ *
  * The iterator iterates in the order of the elements being loaded into this list.
  */
 template <class T> class LinkedList {
@@ -22,9 +29,24 @@ template <class T> class LinkedList {
             next = previous = NULL;
         }
     };
-    Entry *first, *last;
+    Entry *first, *last, *pool;
     int sz;
 
+    Entry* newEntry(const T& elem) {
+        if (pool == NULL) return new Entry(elem);
+        Entry *e = pool;
+        pool = pool->next;
+        e->data = elem;
+        e->next = e->previous = NULL;
+        return e;
+    }
+
+    void freeEntry(Entry *e) {
+        e->data = T();
+        e->next = pool;
+        pool = e;
+    }
+
     Entry* getEntry(int n) {
         Entry *e;
         if (n < sz / 2) {
@@ -47,19 +69,86 @@ template <class T> class LinkedList {
             if (e == first) {
                 first = first->next;
                 first->previous = NULL;
-                delete e;
             }
             else if (e == last) {
                 last = last->previous;
                 last->next = NULL;
-                delete e;
             }
             else {
                 e->next->previous = e->previous;
                 e->previous->next = e->next;
-                delete e;
             }
         }
+        freeEntry(e);
+    }
+
+    void checkOwner(const LinkedList *lnk) const {
+        if (lnk != this)
+            throw ElementNotExist("\nIterator of Another List\n");
+    }
+
+    /**
+     * Takes all nodes of c, leaving it empty; c's pool stays with c.
+     */
+    void detachAll(LinkedList &c, Entry *&head, Entry *&tail, int &n) {
+        head = c.first; tail = c.last; n = c.sz;
+        c.first = c.last = NULL;
+        c.sz = 0;
+    }
+
+    /**
+     * Inserts elem in front of after, or at the end if after is NULL.
+     */
+    Entry* insertBefore(Entry *after, const T& elem) {
+        Entry *e = newEntry(elem);
+        if (after == NULL) {
+            addLastEntry(e);
+            return e;
+        }
+        e->next = after;
+        e->previous = after->previous;
+        if (after->previous == NULL)
+            first = e;
+        else after->previous->next = e;
+        after->previous = e;
+        sz++;
+        return e;
+    }
+
+    /**
+     * Merges two sorted NULL-terminated chains linked by next only.
+     * On ties the element of a comes first, which keeps the sort stable.
+     */
+    template <class C>
+    static Entry* mergeChains(Entry *a, Entry *b) {
+        Entry *res = NULL, **tail = &res;
+        while (a != NULL && b != NULL) {
+            if (C::compare(b->data, a->data) < 0) {
+                *tail = b;
+                b = b->next;
+            }
+            else {
+                *tail = a;
+                a = a->next;
+            }
+            tail = &(*tail)->next;
+        }
+        *tail = a != NULL ? a : b;
+        return res;
+    }
+
+    /**
+     * Makes the chain starting at head the content of this list, setting
+     * the previous links and the last entry again.
+     */
+    void relink(Entry *head) {
+        first = head;
+        Entry *prev = NULL;
+        for (Entry *e = head; e != NULL; e = e->next) {
+            e->previous = prev;
+            prev = e;
+        }
+        last = prev;
     }
 
     void addLastEntry(Entry *e) {
@@ -119,6 +208,7 @@ template <class T> class LinkedList {
     };
 
     class Iterator {
+        friend class LinkedList;
         private:
         LinkedList *lnk;
         Entry *cnt, *lastRet;
@@ -149,7 +239,7 @@ template <class T> class LinkedList {
 
         /**
          * Removes from the underlying collection the last element returned by the iterator (optional operation).
-         * O(n)
+         * O(1)
          * @throw ElementNotExist
          */
         void remove() { 
@@ -160,9 +250,129 @@ template <class T> class LinkedList {
         }
     };
 
+    /**
+     * An iterator which moves in both directions and edits the list at its
+     * cursor. The cursor lies between the element previous() would return
+     * and the element next() would return.
+     */
+    class ListIterator {
+        private:
+        LinkedList *lnk;
+        Entry *nxt, *lastRet;
+        int index;
+
+        public:
+        void init(LinkedList *_lnk, Entry *_nxt, int _index) {
+            lnk = _lnk; nxt = _nxt; index = _index; lastRet = NULL;
+        }
+
+        /**
+         * Returns true if next() would return an element.
+         * O(1)
+         */
+        bool hasNext() {
+            return nxt != NULL;
+        }
+
+        /**
+         * Returns the next element and moves the cursor forward.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        T& next() {
+            if (nxt == NULL)
+                throw ElementNotExist("\nNo Such Element\n");
+            lastRet = nxt; nxt = nxt->next; index++;
+            return lastRet->data;
+        }
+
+        /**
+         * Returns true if previous() would return an element.
+         * O(1)
+         */
+        bool hasPrevious() {
+            return (nxt == NULL ? lnk->last : nxt->previous) != NULL;
+        }
+
+        /**
+         * Returns the previous element and moves the cursor backward.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        T& previous() {
+            Entry *prev = nxt == NULL ? lnk->last : nxt->previous;
+            if (prev == NULL)
+                throw ElementNotExist("\nNo Such Element\n");
+            lastRet = nxt = prev; index--;
+            return lastRet->data;
+        }
+
+        /**
+         * Returns the index of the element next() would return.
+         * O(1)
+         */
+        int nextIndex() {
+            return index;
+        }
+
+        /**
+         * Returns the index of the element previous() would return.
+         * O(1)
+         */
+        int previousIndex() {
+            return index - 1;
+        }
+
+        /**
+         * Replaces the element last returned by next() or previous().
+         * O(1)
+         * @throw ElementNotExist
+         */
+        void set(const T& elem) {
+            if (lastRet == NULL)
+                throw ElementNotExist("\nIllegal State\n");
+            lastRet->data = elem;
+        }
+
+        /**
+         * Removes the element last returned by next() or previous().
+         * O(1)
+         * @throw ElementNotExist
+         */
+        void remove() {
+            if (lastRet == NULL)
+                throw ElementNotExist("\nIllegal State\n");
+            if (lastRet == nxt) nxt = nxt->next;
+            else index--;
+            lnk->removeEntry(lastRet);
+            lastRet = NULL;
+        }
+
+        /**
+         * Inserts an element just before the cursor: next() is unaffected
+         * and previous() would return the new element.
+         * O(1)
+         */
+        void addBefore(const T& elem) {
+            lnk->insertBefore(nxt, elem);
+            index++;
+            lastRet = NULL;
+        }
+
+        /**
+         * Inserts an element just after the cursor: next() would return
+         * the new element.
+         * O(1)
+         */
+        void addAfter(const T& elem) {
+            nxt = lnk->insertBefore(nxt, elem);
+            lastRet = NULL;
+        }
+    };
+
     void init() {
         sz = 0;
-        first = last = NULL;
+        first = last = pool = NULL;
     }
 
     /**
@@ -186,6 +396,7 @@ template <class T> class LinkedList {
      * You may utilize the ``addAll'' function from Utility.h
      */
     LinkedList<T>& operator = (const LinkedList<T> &c) {
+        if (this == &c) return *this;
         clear();
         addAll(*this, c);
         return *this;
@@ -207,6 +418,7 @@ template <class T> class LinkedList {
      */
     ~LinkedList() {
        clear(); 
+       trimToSize();
     }
 
     /**
@@ -217,18 +429,7 @@ template <class T> class LinkedList {
      */
     void add(int index, const T& elem) {
         checkBoundInclusive(index);
-        Entry *e = new Entry(elem);
-        if (index < sz) {
-            Entry *after = getEntry(index);
-            e->next = after;
-            e->previous = after->previous;
-            if (after->previous == NULL)
-                first = e;
-            else after->previous->next = e;
-            after->previous = e;
-            sz++;
-        }
-        else addLastEntry(e);
+        insertBefore(index < sz ? getEntry(index) : NULL, elem);
     }
 
     /**
@@ -237,7 +438,7 @@ template <class T> class LinkedList {
      * Always returns true;
      */
     bool add(const T& elem) {
-        addLastEntry(new Entry(elem));
+        addLastEntry(newEntry(elem));
         return true;
     }
 
@@ -251,10 +452,29 @@ template <class T> class LinkedList {
 
     /**
      * Removes all of the elements from this list.
+     * The nodes are moved to the pool, their elements reset to T().
      * O(n).
      */
     void clear() {
-        while (sz) removeEntry(first);
+        if (sz == 0) return;
+        for (Entry *e = first; e != NULL; e = e->next)
+            e->data = T();
+        last->next = pool;
+        pool = first;
+        first = last = NULL;
+        sz = 0;
+    }
+
+    /**
+     * Frees the nodes kept in the pool for reuse.
+     * O(number of pooled nodes).
+     */
+    void trimToSize() {
+        while (pool != NULL) {
+            Entry *e = pool;
+            pool = pool->next;
+            delete e;
+        }
     }
 
     /**
@@ -373,6 +593,19 @@ template <class T> class LinkedList {
         return CItr;
     }
 
+    /**
+     * Returns a list iterator whose next() returns the element at the
+     * specified position.
+     * O(n).
+     * @throw IndexOutOfBound exception when index is out of bound
+     */
+    ListIterator listIterator(int index = 0) {
+        checkBoundInclusive(index);
+        ListIterator LItr;
+        LItr.init(this, index < sz ? getEntry(index) : NULL, index);
+        return LItr;
+    }
+
     /**
      * Removes the element at the specified position in this list.
      * O(n).
@@ -410,12 +643,8 @@ template <class T> class LinkedList {
      */
     T removeFirst() {
         if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
-        sz--;
         T res = first->data;
-        if (first->next != NULL)
-            first->next->previous = NULL;
-        else last = NULL;
-        first = first->next;
+        removeEntry(first);
         return res;
     }
 
@@ -426,12 +655,8 @@ template <class T> class LinkedList {
      */
     T removeLast() {
         if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
-        sz--;
         T res = last->data;
-        if (last->previous != NULL) 
-            last->previous->next = NULL;
-        else first = NULL;
-        last = last->previous;
+        removeEntry(last);
         return res;
     }
 
@@ -456,6 +681,157 @@ template <class T> class LinkedList {
         return sz;
     }
 
+    /**
+     * Sorts this list into ascending order (operator<).
+     * See the comparator version.
+     */
+    void sort() {
+        sort< Comparator<T> >();
+    }
+
+    /**
+     * Sorts this list with the comparator C (see Comparator in Utility.h).
+     * A stable bottom-up merge sort which only relinks the nodes: runs of
+     * 1, 2, 4, ... nodes are merged like a binary counter, so no element is
+     * copied and no memory is allocated.
+     * O(nlogn).
+     */
+    template <class C>
+    void sort() {
+        if (sz < 2) return;
+        Entry *bins[32];
+        int used = 0;
+        Entry *e = first;
+        while (e != NULL) {
+            Entry *carry = e;
+            e = e->next;
+            carry->next = NULL;
+            int i = 0;
+            for (; i < used && bins[i] != NULL; ++i) {
+                carry = mergeChains<C>(bins[i], carry);
+                bins[i] = NULL;
+            }
+            if (i == used) used++;
+            bins[i] = carry;
+        }
+        Entry *res = NULL;
+        for (int i = 0; i < used; ++i)
+            if (bins[i] != NULL) res = mergeChains<C>(bins[i], res);
+        relink(res);
+    }
+
+    /**
+     * Sorts a list of an integral type into ascending order with an LSD
+     * radix sort on bytes, relinking the nodes through 256 buckets per pass.
+     * Passes on a byte which is the same in all elements are skipped.
+     * Does not compile for a T which is not integral.
+     * O(n * sizeof(T)).
+     */
+    void radixSort() {
+        typedef char RadixSortNeedsIntegralType[std::numeric_limits<T>::is_integer ? 1 : -1];
+        (void)sizeof(RadixSortNeedsIntegralType);
+        if (sz < 2) return;
+        const int BITS = 8 * sizeof(T);
+        const unsigned long long signFlip = T(-1) < T(0) ? 1ULL << (BITS - 1) : 0;
+        Entry *head[256], *tail[256];
+        Entry *res = first;
+        unsigned long long ones = 0, zeros = 0;
+        for (Entry *e = first; e != NULL; e = e->next) {
+            ones |= (unsigned long long)e->data ^ signFlip;
+            zeros |= ~((unsigned long long)e->data ^ signFlip);
+        }
+        for (int shift = 0; shift < BITS; shift += 8) {
+            if (((ones & zeros) >> shift & 255) == 0) continue;
+            for (int i = 0; i < 256; ++i) head[i] = NULL;
+            for (Entry *e = res, *nxt; e != NULL; e = nxt) {
+                nxt = e->next;
+                int d = (int)((((unsigned long long)e->data ^ signFlip) >> shift) & 255);
+                if (head[d] == NULL) head[d] = e;
+                else tail[d]->next = e;
+                tail[d] = e;
+                e->next = NULL;
+            }
+            Entry *h = NULL, *t = NULL;
+            for (int i = 0; i < 256; ++i) {
+                if (head[i] == NULL) continue;
+                if (h == NULL) h = head[i];
+                else t->next = head[i];
+                t = tail[i];
+            }
+            res = h;
+        }
+        relink(res);
+    }
+
+    /**
+     * Moves all elements of other into this list, just before the element
+     * that pos would return next (at the end if pos is exhausted), and
+     * leaves other empty. Nodes are relinked, not copied; pos stays valid.
+     * O(1).
+     * @throw ElementNotExist if pos does not belong to this list
+     */
+    void splice(Iterator &pos, LinkedList<T> &other) {
+        checkOwner(pos.lnk);
+        if (&other == this || other.sz == 0) return;
+        Entry *head, *tail;
+        int n;
+        detachAll(other, head, tail, n);
+        Entry *after = pos.cnt, *before = after == NULL ? last : after->previous;
+        head->previous = before;
+        tail->next = after;
+        if (before == NULL) first = head;
+        else before->next = head;
+        if (after == NULL) last = tail;
+        else after->previous = tail;
+        sz += n;
+    }
+
+    /**
+     * Moves the elements from the one pos would return next to the end
+     * into rest, which is cleared first. Nodes are relinked, not copied;
+     * afterwards pos is at the end of this list. The moved elements are
+     * counted to keep both sizes, since an iterator cannot know its index
+     * once the list has been changed without it.
+     * O(k), k being the number of moved elements.
+     * @throw ElementNotExist if pos does not belong to this list
+     */
+    void splitAt(Iterator &pos, LinkedList<T> &rest) {
+        checkOwner(pos.lnk);
+        if (&rest == this) return;
+        rest.clear();
+        Entry *head = pos.cnt;
+        if (head == NULL) return;
+        int k = 0;
+        for (Entry *e = head; e != NULL; e = e->next)
+            k++;
+        rest.first = head;
+        rest.last = last;
+        rest.sz = k;
+        last = head->previous;
+        if (last == NULL) first = NULL;
+        else last->next = NULL;
+        head->previous = NULL;
+        sz -= k;
+        pos.cnt = NULL;
+    }
+
+    /**
+     * Moves all elements of c to the end of this list, leaving c empty.
+     * Nodes are relinked, not copied.
+     * O(1).
+     */
+    void concat(LinkedList<T> &c) {
+        if (&c == this || c.sz == 0) return;
+        Entry *head, *tail;
+        int n;
+        detachAll(c, head, tail, n);
+        head->previous = last;
+        if (last == NULL) first = head;
+        else last->next = head;
+        last = tail;
+        sz += n;
+    }
+
     /**
      * Returns a view of the portion of this list between the specified
      * fromIndex, inclusive, and toIndex, exclusive.
@@ -0,0 +1,350 @@
+/** @file */
+#ifndef __PERSISTENTTREEMAP_H
+#define __PERSISTENTTREEMAP_H
+
+#include "Utility.h"
+#include<cstdlib>
+
+/**
+ * A PersistentTreeMap is an ordered map that is never changed in place:
+ * put and remove leave the map untouched and return a new version of it.
+ * A new version copies only the O(logn) nodes on the path to the key and
+ * shares every other node with the old one, so copying a map, that is
+ * taking a snapshot, is O(1).
+ *
+ * The tree is an AVL tree. Nodes are immutable once built and carry a
+ * reference count updated atomically, so versions sharing nodes may be
+ * read, copied and destroyed from different threads without locking, as
+ * long as each PersistentTreeMap object is used by one thread at a time.
+ * A node is freed when the last version holding it is destroyed.
+ *
+ * Template argument C is the comparator class, as for TreeMap. For
+ * example:
+ * @code
+ *      PersistentTreeMap<int, int> v1;
+ *      PersistentTreeMap<int, int> v2 = v1.put(1, 10);
+ * @endcode
+ * leaves v1 empty and v2 holding one mapping.
+ */
+template <class K, class V, class C = Comparator<K> >
+class PersistentTreeMap {
+    private:
+    class Node: public Entry<K, V> {
+        public:
+        Node *left, *right;
+        int height, refs;
+        Node(const K& _key, const V& _value, Node *_left, Node *_right):
+            Entry<K, V>(_key, _value), left(_left), right(_right), refs(1) {
+            int hl = heightOf(left), hr = heightOf(right);
+            height = (hl > hr ? hl : hr) + 1;
+        }
+    };
+    Node *root;
+    int sz;
+
+    /**
+     * Takes over one reference to _root.
+     */
+    PersistentTreeMap(Node *_root, int _sz): root(_root), sz(_sz) {}
+
+    static int heightOf(const Node *node) {
+        return node == NULL ? 0 : node->height;
+    }
+
+    static Node* retain(Node *node) {
+        if (node != NULL) __sync_fetch_and_add(&node->refs, 1);
+        return node;
+    }
+
+    /**
+     * Drops one reference to node, freeing it and dropping its children
+     * when it was the last one.
+     */
+    static void release(Node *node) {
+        while (node != NULL && __sync_sub_and_fetch(&node->refs, 1) == 0) {
+            release(node->left);
+            Node *right = node->right;
+            delete node;
+            node = right;
+        }
+    }
+
+    /**
+     * Returns a new node for (key, value) over the subtrees left and
+     * right, taking over one reference to each, rotated if their heights
+     * differ by two.
+     */
+    static Node* balance(const K& key, const V& value, Node *left, Node *right) {
+        int hl = heightOf(left), hr = heightOf(right);
+        Node *res;
+        if (hl > hr + 1) {
+            if (heightOf(left->left) >= heightOf(left->right))
+                res = new Node(left->key, left->value, retain(left->left),
+                        new Node(key, value, retain(left->right), right));
+            else {
+                Node *lr = left->right;
+                res = new Node(lr->key, lr->value,
+                        new Node(left->key, left->value, retain(left->left), retain(lr->left)),
+                        new Node(key, value, retain(lr->right), right));
+            }
+            release(left);
+        }
+        else if (hr > hl + 1) {
+            if (heightOf(right->right) >= heightOf(right->left))
+                res = new Node(right->key, right->value,
+                        new Node(key, value, left, retain(right->left)), retain(right->right));
+            else {
+                Node *rl = right->left;
+                res = new Node(rl->key, rl->value,
+                        new Node(key, value, left, retain(rl->left)),
+                        new Node(right->key, right->value, retain(rl->right), retain(right->right)));
+            }
+            release(right);
+        }
+        else res = new Node(key, value, left, right);
+        return res;
+    }
+
+    /**
+     * Returns the subtree node with key mapped to value, setting added if
+     * the key was absent. node itself is left as it is.
+     */
+    static Node* insert(Node *node, const K& key, const V& value, bool& added) {
+        if (node == NULL) {
+            added = true;
+            return new Node(key, value, NULL, NULL);
+        }
+        int c = C::compare(key, node->key);
+        if (c < 0)
+            return balance(node->key, node->value, insert(node->left, key, value, added), retain(node->right));
+        if (c > 0)
+            return balance(node->key, node->value, retain(node->left), insert(node->right, key, value, added));
+        return new Node(node->key, value, retain(node->left), retain(node->right));
+    }
+
+    /**
+     * Returns the subtree node without its least key.
+     */
+    static Node* eraseFirst(Node *node) {
+        if (node->left == NULL) return retain(node->right);
+        return balance(node->key, node->value, eraseFirst(node->left), retain(node->right));
+    }
+
+    /**
+     * Returns the subtree node without key, which it must contain.
+     */
+    template <class K2>
+    static Node* erase(Node *node, const K2& key) {
+        int c = C::compare(key, node->key);
+        if (c < 0)
+            return balance(node->key, node->value, erase(node->left, key), retain(node->right));
+        if (c > 0)
+            return balance(node->key, node->value, retain(node->left), erase(node->right, key));
+        if (node->left == NULL) return retain(node->right);
+        if (node->right == NULL) return retain(node->left);
+        Node *first = node->right;
+        while (first->left != NULL)
+            first = first->left;
+        return balance(first->key, first->value, retain(node->left), eraseFirst(node->right));
+    }
+
+    template <class K2>
+    Node* getNode(const K2& key) const {
+        Node *current = root;
+        while (current != NULL) {
+            int c = C::compare(key, current->key);
+            if (c > 0) current = current->right;
+            else if (c < 0) current = current->left;
+            else return current;
+        }
+        return NULL;
+    }
+
+    public:
+    class ConstIterator {
+        private:
+        /**
+         * An AVL tree of 2^31 nodes is at most 45 high.
+         */
+        static const int MAX_HEIGHT = 64;
+        const Node *stack[MAX_HEIGHT];
+        int top;
+
+        void pushLeft(const Node *node) {
+            for (; node != NULL; node = node->left)
+                stack[top++] = node;
+        }
+
+        public:
+        void init(const Node *root) {
+            top = 0;
+            pushLeft(root);
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1).
+         */
+        bool hasNext() {
+            return top > 0;
+        }
+
+        /**
+         * Returns a const reference to the next element in the iteration.
+         * Amortized O(1).
+         * @throw ElementNotExist
+         */
+        const Entry<K, V>& next() {
+            if (top == 0) throw ElementNotExist("\nNo Such Element\n");
+            const Node *node = stack[--top];
+            pushLeft(node->right);
+            return *node;
+        }
+    };
+
+    /**
+     * Constructs an empty map.
+     */
+    PersistentTreeMap(): root(NULL), sz(0) {}
+
+    /**
+     * Copy constructor, sharing the whole tree: a snapshot.
+     * O(1).
+     */
+    PersistentTreeMap(const PersistentTreeMap &x): root(retain(x.root)), sz(x.sz) {}
+
+    /**
+     * Constructs a map containing the same mappings as the given map.
+     */
+    template <class M>
+    explicit PersistentTreeMap(const M& m): root(NULL), sz(0) {
+        addAll(*this, m);
+    }
+
+    /**
+     * Makes this object a snapshot of x.
+     * O(1), plus the nodes freed from the previous version.
+     */
+    PersistentTreeMap& operator = (const PersistentTreeMap &x) {
+        Node *old = root;
+        root = retain(x.root);
+        sz = x.sz;
+        release(old);
+        return *this;
+    }
+
+    /**
+     * Destructor, freeing the nodes no other version holds.
+     */
+    ~PersistentTreeMap() {
+        release(root);
+    }
+
+    /**
+     * Returns an const iterator over the elements of this version, in key
+     * order. It stays valid while a version holding the same tree lives.
+     * O(logn).
+     */
+    ConstIterator constIterator() const {
+        ConstIterator CItr;
+        CItr.init(root);
+        return CItr;
+    }
+
+    /**
+     * Returns true if this map contains a mapping for the specified key.
+     * O(logn).
+     */
+    template <class K2>
+    bool containsKey(const K2& key) const {
+        return getNode(key) != NULL;
+    }
+
+    /**
+     * Returns a const reference to the value to which the specified key
+     * is mapped.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    template <class K2>
+    const V& get(const K2& key) const {
+        Node *node = getNode(key);
+        if (node == NULL) throw ElementNotExist("\nNo Such Element\n");
+        return node->value;
+    }
+
+    /**
+     * Returns the first (lowest) key of this map.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const K& firstKey() const {
+        if (root == NULL) throw ElementNotExist("\nNo Such Element\n");
+        Node *node = root;
+        while (node->left != NULL)
+            node = node->left;
+        return node->key;
+    }
+
+    /**
+     * Returns the last (highest) key of this map.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const K& lastKey() const {
+        if (root == NULL) throw ElementNotExist("\nNo Such Element\n");
+        Node *node = root;
+        while (node->right != NULL)
+            node = node->right;
+        return node->key;
+    }
+
+    /**
+     * Returns true if this map contains no key-value mappings.
+     * O(1).
+     */
+    bool isEmpty() const {
+        return sz == 0;
+    }
+
+    /**
+     * Returns a new version of this map in which the specified key is
+     * mapped to the specified value.
+     * O(logn).
+     */
+    PersistentTreeMap put(const K& key, const V& value) const {
+        bool added = false;
+        Node *node = insert(root, key, value, added);
+        return PersistentTreeMap(node, added ? sz + 1 : sz);
+    }
+
+    /**
+     * Returns a new version of this map without the mapping for the
+     * specified key.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    template <class K2>
+    PersistentTreeMap remove(const K2& key) const {
+        if (getNode(key) == NULL) throw ElementNotExist("\nNo Such Element\n");
+        return PersistentTreeMap(erase(root, key), sz - 1);
+    }
+
+    /**
+     * Replaces this object by the version with e added, so that addAll
+     * fills a PersistentTreeMap. Other versions are not affected.
+     */
+    void add(const Entry<K, V>& e) {
+        *this = put(e.key, e.value);
+    }
+
+    /**
+     * Returns the number of key-value mappings in this map.
+     * O(1).
+     */
+    int size() const {
+        return sz;
+    }
+};
+
+#endif
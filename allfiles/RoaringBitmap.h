@@ -0,0 +1,771 @@
+/** @file */
+#ifndef __ROARINGBITMAP_H
+#define __ROARINGBITMAP_H
+
+#include "Utility.h"
+#include<cstring>
+
+/**
+ * A compressed set of ints in the style of Roaring bitmaps.
+ *
+ * The 32-bit values are split by their high 16 bits into chunks of 65536
+ * values. Each non-empty chunk is kept in a container chosen by its density:
+ * a sorted array of the low 16 bits when it holds at most 4096 values, a
+ * 65536-bit bitmap otherwise, or a list of runs after runOptimize() found
+ * runs to be smaller. Dense sets of IDs therefore cost about one or two bytes
+ * per element instead of a heap node per element as in HashSet<int, H>.
+ *
+ * The iterators have the same protocol as those of HashSet, so ``addAll''
+ * and ``containsAll'' work across both. Elements are iterated in ascending
+ * order of their unsigned representation.
+ */
+class RoaringBitmap {
+    private:
+    static const int ARRAY = 0, BITMAP = 1, RUN = 2;
+    static const int ARRAY_MAX = 4096, BITMAP_WORDS = 1024;
+
+    class Container {
+        public:
+        /**
+         * ARRAY: arr[0 .. card) holds the sorted values.
+         * BITMAP: bits holds one bit per value.
+         * RUN: arr[0 .. 2 * len) holds pairs of (start, length - 1).
+         */
+        int type, card, len, capa;
+        unsigned short *arr;
+        unsigned long long *bits;
+
+        Container(int _type, int _capa): type(_type), card(0), len(0), capa(_capa), arr(NULL), bits(NULL) {
+            if (type == BITMAP) {
+                bits = new unsigned long long[BITMAP_WORDS];
+                memset(bits, 0, BITMAP_WORDS * sizeof(unsigned long long));
+            }
+            else arr = new unsigned short[capa];
+        }
+
+        Container(const Container &c): type(c.type), card(c.card), len(c.len), capa(c.capa), arr(NULL), bits(NULL) {
+            if (type == BITMAP) {
+                bits = new unsigned long long[BITMAP_WORDS];
+                memcpy(bits, c.bits, BITMAP_WORDS * sizeof(unsigned long long));
+            }
+            else {
+                arr = new unsigned short[capa];
+                memcpy(arr, c.arr, capa * sizeof(unsigned short));
+            }
+        }
+
+        ~Container() {
+            delete [] arr;
+            delete [] bits;
+        }
+
+        /**
+         * Returns the index of v in the sorted array, or -(insertion point + 1).
+         */
+        int search(unsigned short v) const {
+            int lo = 0, hi = card - 1;
+            while (lo <= hi) {
+                int mid = (lo + hi) >> 1;
+                if (arr[mid] < v) lo = mid + 1;
+                else if (arr[mid] > v) hi = mid - 1;
+                else return mid;
+            }
+            return -(lo + 1);
+        }
+
+        /**
+         * Returns the index of the last run starting at or before v, or -1.
+         */
+        int searchRun(unsigned short v) const {
+            int lo = 0, hi = len - 1;
+            while (lo <= hi) {
+                int mid = (lo + hi) >> 1;
+                if (arr[2 * mid] <= v) lo = mid + 1;
+                else hi = mid - 1;
+            }
+            return hi;
+        }
+
+        bool contains(unsigned short v) const {
+            if (type == ARRAY) return search(v) >= 0;
+            if (type == BITMAP) return (bits[v >> 6] >> (v & 63)) & 1;
+            int r = searchRun(v);
+            return r >= 0 && v - arr[2 * r] <= arr[2 * r + 1];
+        }
+
+        void setBit(unsigned short v) {
+            bits[v >> 6] |= 1ULL << (v & 63);
+        }
+
+        void setRange(int from, int to) {
+            for (int v = from; v <= to; ) {
+                if ((v & 63) == 0 && v + 63 <= to) {
+                    bits[v >> 6] = ~0ULL;
+                    v += 64;
+                }
+                else setBit((unsigned short)v++);
+            }
+        }
+
+        void countBits() {
+            card = 0;
+            for (int i = 0; i < BITMAP_WORDS; ++i)
+                card += __builtin_popcountll(bits[i]);
+        }
+
+        /**
+         * Replaces the storage of this container by a bitmap.
+         */
+        void toBitmap() {
+            unsigned long long *b = new unsigned long long[BITMAP_WORDS];
+            memset(b, 0, BITMAP_WORDS * sizeof(unsigned long long));
+            bits = b;
+            if (type == ARRAY) {
+                for (int i = 0; i < card; ++i) setBit(arr[i]);
+            }
+            else {
+                for (int i = 0; i < len; ++i)
+                    setRange(arr[2 * i], arr[2 * i] + arr[2 * i + 1]);
+            }
+            delete [] arr;
+            arr = NULL;
+            type = BITMAP;
+        }
+
+        /**
+         * Replaces the storage of this container by a sorted array.
+         */
+        void toArray() {
+            unsigned short *a = new unsigned short[capa = card > 4 ? card : 4];
+            int k = 0;
+            if (type == BITMAP) {
+                for (int i = 0; i < BITMAP_WORDS; ++i) {
+                    unsigned long long w = bits[i];
+                    while (w) {
+                        a[k++] = (unsigned short)(i * 64 + __builtin_ctzll(w));
+                        w &= w - 1;
+                    }
+                }
+                delete [] bits;
+                bits = NULL;
+            }
+            else {
+                for (int i = 0; i < len; ++i)
+                    for (int j = 0; j <= arr[2 * i + 1]; ++j)
+                        a[k++] = (unsigned short)(arr[2 * i] + j);
+                delete [] arr;
+            }
+            arr = a;
+            len = 0;
+            type = ARRAY;
+        }
+
+        /**
+         * Turns a run container back into an array or a bitmap, which are
+         * the forms that support updates.
+         */
+        void unrun() {
+            if (type != RUN) return;
+            if (card <= ARRAY_MAX) toArray();
+            else toBitmap();
+        }
+
+        /**
+         * Converts this container into runs if that takes less memory.
+         */
+        void runOptimize() {
+            if (type == RUN) return;
+            int runs = 0;
+            if (type == ARRAY) {
+                for (int i = 0; i < card; ++i)
+                    if (i == 0 || arr[i] != arr[i - 1] + 1) runs++;
+            }
+            else {
+                for (int v = 0; v < 65536; ++v)
+                    if (contains((unsigned short)v) && (v == 0 || !contains((unsigned short)(v - 1)))) runs++;
+            }
+            int bytes = type == ARRAY ? 2 * card : BITMAP_WORDS * 8;
+            if (4 * runs >= bytes) return;
+            unsigned short *r = new unsigned short[capa = 2 * runs];
+            int k = -1, prev = -2;
+            for (int v = 0, i = 0; type == ARRAY ? i < card : v < 65536; ++v) {
+                int x;
+                if (type == ARRAY) x = arr[i++];
+                else if (contains((unsigned short)v)) x = v;
+                else continue;
+                if (x != prev + 1) {
+                    r[2 * ++k] = (unsigned short)x;
+                    r[2 * k + 1] = 0;
+                }
+                else r[2 * k + 1]++;
+                prev = x;
+            }
+            delete [] arr;
+            delete [] bits;
+            bits = NULL;
+            arr = r;
+            len = runs;
+            type = RUN;
+        }
+
+        bool add(unsigned short v) {
+            unrun();
+            if (type == BITMAP) {
+                if (contains(v)) return false;
+                setBit(v);
+                card++;
+                return true;
+            }
+            int pos = search(v);
+            if (pos >= 0) return false;
+            if (card == ARRAY_MAX) {
+                toBitmap();
+                setBit(v);
+                card++;
+                return true;
+            }
+            pos = -pos - 1;
+            if (card == capa) {
+                unsigned short *a = new unsigned short[capa = capa * 2 < ARRAY_MAX ? capa * 2 : ARRAY_MAX];
+                memcpy(a, arr, card * sizeof(unsigned short));
+                delete [] arr;
+                arr = a;
+            }
+            memmove(arr + pos + 1, arr + pos, (card - pos) * sizeof(unsigned short));
+            arr[pos] = v;
+            card++;
+            return true;
+        }
+
+        bool remove(unsigned short v) {
+            if (!contains(v)) return false;
+            unrun();
+            if (type == BITMAP) {
+                bits[v >> 6] &= ~(1ULL << (v & 63));
+                if (--card <= ARRAY_MAX) toArray();
+                return true;
+            }
+            int pos = search(v);
+            memmove(arr + pos, arr + pos + 1, (card - pos - 1) * sizeof(unsigned short));
+            card--;
+            return true;
+        }
+
+        /**
+         * Returns the first value not less than v, or -1.
+         */
+        int nextValue(int v) const {
+            if (v > 65535) return -1;
+            if (type == ARRAY) {
+                int pos = search((unsigned short)v);
+                if (pos < 0) pos = -pos - 1;
+                return pos < card ? arr[pos] : -1;
+            }
+            if (type == RUN) {
+                int r = searchRun((unsigned short)v);
+                if (r >= 0 && v - arr[2 * r] <= arr[2 * r + 1]) return v;
+                return r + 1 < len ? arr[2 * (r + 1)] : -1;
+            }
+            int w = v >> 6;
+            unsigned long long word = bits[w] & (~0ULL << (v & 63));
+            while (word == 0) {
+                if (++w == BITMAP_WORDS) return -1;
+                word = bits[w];
+            }
+            return w * 64 + __builtin_ctzll(word);
+        }
+    };
+
+    unsigned short *keys;
+    Container **conts;
+    int nc, capc, sz;
+
+    /**
+     * Returns the index of the container for key, or -(insertion point + 1).
+     */
+    int findKey(unsigned short key) const {
+        int lo = 0, hi = nc - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) >> 1;
+            if (keys[mid] < key) lo = mid + 1;
+            else if (keys[mid] > key) hi = mid - 1;
+            else return mid;
+        }
+        return -(lo + 1);
+    }
+
+    void ensureContainers(int minCapacity) {
+        if (minCapacity <= capc) return;
+        capc = capc * 2 > minCapacity ? capc * 2 : minCapacity;
+        unsigned short *k = new unsigned short[capc];
+        Container **c = new Container*[capc];
+        memcpy(k, keys, nc * sizeof(unsigned short));
+        memcpy(c, conts, nc * sizeof(Container*));
+        delete [] keys;
+        delete [] conts;
+        keys = k; conts = c;
+    }
+
+    void insertContainer(int pos, unsigned short key, Container *c) {
+        ensureContainers(nc + 1);
+        memmove(keys + pos + 1, keys + pos, (nc - pos) * sizeof(unsigned short));
+        memmove(conts + pos + 1, conts + pos, (nc - pos) * sizeof(Container*));
+        keys[pos] = key; conts[pos] = c;
+        nc++;
+    }
+
+    void removeContainer(int pos) {
+        delete conts[pos];
+        memmove(keys + pos, keys + pos + 1, (nc - pos - 1) * sizeof(unsigned short));
+        memmove(conts + pos, conts + pos + 1, (nc - pos - 1) * sizeof(Container*));
+        nc--;
+    }
+
+    /**
+     * Appends a container holding a bigger key than all present ones.
+     * Empty results (NULL or zero cardinality) are dropped.
+     */
+    void appendContainer(unsigned short key, Container *c) {
+        if (c == NULL) return;
+        if (c->card == 0) {
+            delete c;
+            return;
+        }
+        ensureContainers(nc + 1);
+        keys[nc] = key; conts[nc++] = c;
+        sz += c->card;
+    }
+
+    static Container* shrink(Container *c) {
+        if (c->type == BITMAP && c->card <= ARRAY_MAX) c->toArray();
+        return c;
+    }
+
+    static Container* andContainers(const Container *a, const Container *b) {
+        if (b->type == ARRAY && (a->type != ARRAY || b->card < a->card)) {
+            const Container *t = a; a = b; b = t;
+        }
+        if (a->type == ARRAY) {
+            Container *c = new Container(ARRAY, a->card > 4 ? a->card : 4);
+            for (int i = 0; i < a->card; ++i)
+                if (b->contains(a->arr[i])) c->arr[c->card++] = a->arr[i];
+            return c;
+        }
+        Container *x = new Container(*a), *y = NULL;
+        x->unrun();
+        if (x->type == ARRAY) {
+            Container *c = andContainers(x, b);
+            delete x;
+            return c;
+        }
+        if (b->type != BITMAP) {
+            y = new Container(*b);
+            y->toBitmap();
+            b = y;
+        }
+        for (int i = 0; i < BITMAP_WORDS; ++i) x->bits[i] &= b->bits[i];
+        delete y;
+        x->countBits();
+        return shrink(x);
+    }
+
+    static Container* orContainers(const Container *a, const Container *b) {
+        if (a->type == ARRAY && b->type == ARRAY && a->card + b->card <= ARRAY_MAX) {
+            Container *c = new Container(ARRAY, a->card + b->card > 4 ? a->card + b->card : 4);
+            int i = 0, j = 0;
+            while (i < a->card || j < b->card) {
+                if (j == b->card || (i < a->card && a->arr[i] < b->arr[j])) c->arr[c->card++] = a->arr[i++];
+                else if (i == a->card || b->arr[j] < a->arr[i]) c->arr[c->card++] = b->arr[j++];
+                else {
+                    c->arr[c->card++] = a->arr[i++];
+                    j++;
+                }
+            }
+            return c;
+        }
+        if (b->type == BITMAP) {
+            const Container *t = a; a = b; b = t;
+        }
+        Container *x = new Container(*a);
+        if (x->type != BITMAP) x->toBitmap();
+        if (b->type == ARRAY) {
+            for (int i = 0; i < b->card; ++i) x->setBit(b->arr[i]);
+        }
+        else if (b->type == RUN) {
+            for (int i = 0; i < b->len; ++i)
+                x->setRange(b->arr[2 * i], b->arr[2 * i] + b->arr[2 * i + 1]);
+        }
+        else {
+            for (int i = 0; i < BITMAP_WORDS; ++i) x->bits[i] |= b->bits[i];
+        }
+        x->countBits();
+        return shrink(x);
+    }
+
+    static Container* andNotContainers(const Container *a, const Container *b) {
+        if (a->type == ARRAY) {
+            Container *c = new Container(ARRAY, a->card > 4 ? a->card : 4);
+            for (int i = 0; i < a->card; ++i)
+                if (!b->contains(a->arr[i])) c->arr[c->card++] = a->arr[i];
+            return c;
+        }
+        Container *x = new Container(*a);
+        x->unrun();
+        if (x->type == ARRAY) {
+            Container *c = andNotContainers(x, b);
+            delete x;
+            return c;
+        }
+        if (b->type == ARRAY) {
+            for (int i = 0; i < b->card; ++i)
+                x->bits[b->arr[i] >> 6] &= ~(1ULL << (b->arr[i] & 63));
+        }
+        else {
+            Container *y = NULL;
+            if (b->type == RUN) {
+                y = new Container(*b);
+                y->toBitmap();
+                b = y;
+            }
+            for (int i = 0; i < BITMAP_WORDS; ++i) x->bits[i] &= ~b->bits[i];
+            delete y;
+        }
+        x->countBits();
+        return shrink(x);
+    }
+
+    void init() {
+        nc = sz = 0;
+        capc = 4;
+        keys = new unsigned short[capc];
+        conts = new Container*[capc];
+    }
+
+    void copyFrom(const RoaringBitmap &c) {
+        ensureContainers(c.nc);
+        for (int i = 0; i < c.nc; ++i) {
+            keys[i] = c.keys[i];
+            conts[i] = new Container(*c.conts[i]);
+        }
+        nc = c.nc;
+        sz = c.sz;
+    }
+
+    /**
+     * Positions a cursor at the first element not less than the unsigned
+     * value v. Used by the iterators.
+     */
+    void locate(unsigned int v, int &ci, int &low) const {
+        int pos = findKey((unsigned short)(v >> 16));
+        ci = pos < 0 ? -pos - 1 : pos;
+        low = pos < 0 ? 0 : (int)(v & 0xFFFF);
+        while (ci < nc && (low = conts[ci]->nextValue(low)) < 0) {
+            ci++;
+            low = 0;
+        }
+    }
+
+    public:
+    class ConstIterator {
+        private:
+        const RoaringBitmap *rb;
+        int cnt, ci, low, cur;
+
+        public:
+        void init(const RoaringBitmap *_rb) {
+            rb = _rb; cnt = rb->sz;
+            rb->locate(0, ci, low);
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return cnt > 0;
+        }
+
+        /**
+         * Returns the next element in the iteration.
+         * O(1) for arrays and runs, O(n) in total for bitmaps.
+         * @throw ElementNotExist
+         */
+        const int& next() {
+            if (cnt == 0) throw ElementNotExist("\nNo Such Element\n");
+            cnt--;
+            cur = (int)(((unsigned int)rb->keys[ci] << 16) | low);
+            if ((low = rb->conts[ci]->nextValue(low + 1)) < 0)
+                rb->locate((((unsigned int)rb->keys[ci]) + 1) << 16, ci, low);
+            return cur;
+        }
+    };
+
+    class Iterator {
+        private:
+        RoaringBitmap *rb;
+        int cnt, ci, low, cur;
+        bool canRemove;
+
+        public:
+        void init(RoaringBitmap *_rb) {
+            rb = _rb; cnt = rb->sz; canRemove = false;
+            rb->locate(0, ci, low);
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return cnt > 0;
+        }
+
+        /**
+         * Returns the next element in the iteration.
+         * O(1) for arrays and runs, O(n) in total for bitmaps.
+         * @throw ElementNotExist
+         */
+        const int& next() {
+            if (cnt == 0) throw ElementNotExist("\nNo Such Element\n");
+            cnt--;
+            cur = (int)(((unsigned int)rb->keys[ci] << 16) | low);
+            if ((low = rb->conts[ci]->nextValue(low + 1)) < 0)
+                rb->locate((((unsigned int)rb->keys[ci]) + 1) << 16, ci, low);
+            canRemove = true;
+            return cur;
+        }
+
+        /**
+         * Removes from the underlying collection the last element
+         * returned by the iterator.
+         * O(log n), the cursor is looked up again after the removal.
+         * @throw ElementNotExist
+         */
+        void remove() {
+            if (!canRemove) throw ElementNotExist("\nIllegal State\n");
+            rb->remove(cur);
+            canRemove = false;
+            if (cnt > 0) rb->locate((unsigned int)cur + 1, ci, low);
+        }
+    };
+
+    /**
+     * Constructs an empty set
+     */
+    RoaringBitmap() {
+        init();
+    }
+
+    /**
+     * Copy constructor
+     */
+    RoaringBitmap(const RoaringBitmap &c) {
+        init();
+        copyFrom(c);
+    }
+
+    /**
+     * Constructs a new set containing the elements in the specified
+     * collection.
+     */
+    template<class C> explicit RoaringBitmap(const C& c) {
+        init();
+        addAll(*this, c);
+    }
+
+    /**
+     * Assignment operator
+     */
+    RoaringBitmap& operator = (const RoaringBitmap &c) {
+        if (this == &c) return *this;
+        clear();
+        copyFrom(c);
+        return *this;
+    }
+
+    /**
+     * Destructor
+     */
+    ~RoaringBitmap() {
+        clear();
+        delete [] keys;
+        delete [] conts;
+    }
+
+    /**
+     * Adds the specified element to this set if it is not already present.
+     * Returns false if element is previously in the set.
+     * O(log n) to find the chunk, plus O(4096) in the worst case for an array.
+     */
+    bool add(int elem) {
+        unsigned int v = (unsigned int)elem;
+        int pos = findKey((unsigned short)(v >> 16));
+        if (pos < 0) {
+            pos = -pos - 1;
+            insertContainer(pos, (unsigned short)(v >> 16), new Container(ARRAY, 4));
+        }
+        if (!conts[pos]->add((unsigned short)(v & 0xFFFF))) return false;
+        sz++;
+        return true;
+    }
+
+    /**
+     * Removes all of the elements from this set.
+     */
+    void clear() {
+        for (int i = 0; i < nc; ++i) delete conts[i];
+        nc = sz = 0;
+    }
+
+    /**
+     * Returns true if this set contains the specified element.
+     * O(log n)
+     */
+    bool contains(int elem) const {
+        unsigned int v = (unsigned int)elem;
+        int pos = findKey((unsigned short)(v >> 16));
+        return pos >= 0 && conts[pos]->contains((unsigned short)(v & 0xFFFF));
+    }
+
+    /**
+     * Returns true if this set contains no elements.
+     * O(1)
+     */
+    bool isEmpty() const {
+        return sz == 0;
+    }
+
+    /**
+     * Returns an iterator over the elements in this set.
+     */
+    Iterator iterator() {
+        Iterator Itr;
+        Itr.init(this);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator over the elements in this set.
+     */
+    ConstIterator constIterator() const {
+        ConstIterator CItr;
+        CItr.init(this);
+        return CItr;
+    }
+
+    /**
+     * Removes the specified element from this set if it is present.
+     * O(log n) to find the chunk, plus O(4096) in the worst case for an array.
+     */
+    bool remove(int elem) {
+        unsigned int v = (unsigned int)elem;
+        int pos = findKey((unsigned short)(v >> 16));
+        if (pos < 0 || !conts[pos]->remove((unsigned short)(v & 0xFFFF))) return false;
+        if (conts[pos]->card == 0) removeContainer(pos);
+        sz--;
+        return true;
+    }
+
+    /**
+     * Returns the number of elements in this set (its cardinality).
+     * O(1)
+     */
+    int size() const {
+        return sz;
+    }
+
+    /**
+     * Stores every chunk as a list of runs when that is smaller than its
+     * array or bitmap. Worth calling once a set of long ID ranges is built;
+     * a chunk goes back to an array or a bitmap on its next update.
+     * O(n)
+     */
+    void runOptimize() {
+        for (int i = 0; i < nc; ++i) conts[i]->runOptimize();
+    }
+
+    /**
+     * Returns a new set containing the elements in either this set or c (OR).
+     * Bitmaps are combined a word at a time.
+     * O(n + m)
+     */
+    RoaringBitmap unionWith(const RoaringBitmap &c) const {
+        RoaringBitmap res;
+        res.ensureContainers(nc + c.nc);
+        int i = 0, j = 0;
+        while (i < nc || j < c.nc) {
+            if (j == c.nc || (i < nc && keys[i] < c.keys[j])) {
+                res.appendContainer(keys[i], new Container(*conts[i]));
+                i++;
+            }
+            else if (i == nc || c.keys[j] < keys[i]) {
+                res.appendContainer(c.keys[j], new Container(*c.conts[j]));
+                j++;
+            }
+            else {
+                res.appendContainer(keys[i], orContainers(conts[i], c.conts[j]));
+                i++; j++;
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Returns a new set containing the elements in both this set and c (AND).
+     * Chunks present on one side only are skipped without being read.
+     * O(n + m)
+     */
+    RoaringBitmap intersectWith(const RoaringBitmap &c) const {
+        RoaringBitmap res;
+        int i = 0, j = 0;
+        while (i < nc && j < c.nc) {
+            if (keys[i] < c.keys[j]) i++;
+            else if (c.keys[j] < keys[i]) j++;
+            else {
+                res.appendContainer(keys[i], andContainers(conts[i], c.conts[j]));
+                i++; j++;
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Returns a new set containing the elements in this set but not in c
+     * (ANDNOT).
+     * O(n + m)
+     */
+    RoaringBitmap differenceWith(const RoaringBitmap &c) const {
+        RoaringBitmap res;
+        res.ensureContainers(nc);
+        int j = 0;
+        for (int i = 0; i < nc; ++i) {
+            while (j < c.nc && c.keys[j] < keys[i]) j++;
+            if (j < c.nc && c.keys[j] == keys[i])
+                res.appendContainer(keys[i], andNotContainers(conts[i], c.conts[j]));
+            else res.appendContainer(keys[i], new Container(*conts[i]));
+        }
+        return res;
+    }
+
+    /**
+     * Returns true if this set and c have no element in common.
+     * O(n + m)
+     */
+    bool isDisjoint(const RoaringBitmap &c) const {
+        int i = 0, j = 0;
+        while (i < nc && j < c.nc) {
+            if (keys[i] < c.keys[j]) i++;
+            else if (c.keys[j] < keys[i]) j++;
+            else {
+                Container *x = andContainers(conts[i], c.conts[j]);
+                bool empty = x->card == 0;
+                delete x;
+                if (!empty) return false;
+                i++; j++;
+            }
+        }
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,509 @@
+/** @file */
+#ifndef __TREELIST_H
+#define __TREELIST_H
+
+#include "Utility.h"
+#include<cstdio>
+
+/**
+ * A list with the interface of ArrayList, stored in a balanced tree keyed by
+ * position (an implicit treap) so that inserting or removing in the middle
+ * of a long list is O(logn) instead of the O(n) memmove of ArrayList.
+ *
+ * Each node remembers the size of its subtree, which locates an index in
+ * O(logn), and a random priority that keeps the tree balanced with high
+ * probability. Whole ranges are cut off and joined again in O(logn) with
+ * splitAt() and concat().
+ *
+ * The iterator iterates in the order of the elements being loaded into this list
+ */
+template <class E>
+class TreeList {
+    private:
+    class Node {
+        public:
+        E data;
+        Node *left, *right, *parent;
+        int size;
+        unsigned int priority;
+        Node(const E& _data, unsigned int _priority): data(_data), left(NULL), right(NULL), parent(NULL), size(1), priority(_priority) {}
+    };
+    Node *root;
+    unsigned int seed;
+
+    /**
+     * Lists get different priority sequences, so that joining two lists
+     * with concat() keeps the result balanced.
+     */
+    unsigned int initialSeed() const {
+        return (2463534242U ^ (unsigned int)(size_t)this) | 1;
+    }
+
+    unsigned int nextPriority() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    static int sizeOf(Node *node) {
+        return node == NULL ? 0 : node->size;
+    }
+
+    static void update(Node *node) {
+        node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+        if (node->left != NULL) node->left->parent = node;
+        if (node->right != NULL) node->right->parent = node;
+    }
+
+    /**
+     * Joins two trees, all elements of a coming before those of b.
+     */
+    static Node* merge(Node *a, Node *b) {
+        if (a == NULL) return b;
+        if (b == NULL) return a;
+        if (a->priority > b->priority) {
+            a->right = merge(a->right, b);
+            update(a);
+            return a;
+        }
+        b->left = merge(a, b->left);
+        update(b);
+        return b;
+    }
+
+    /**
+     * Splits a tree into its first k elements (a) and the rest (b).
+     */
+    static void split(Node *node, int k, Node *&a, Node *&b) {
+        if (node == NULL) {
+            a = b = NULL;
+            return;
+        }
+        if (sizeOf(node->left) < k) {
+            split(node->right, k - sizeOf(node->left) - 1, node->right, b);
+            update(node);
+            a = node;
+        }
+        else {
+            split(node->left, k, a, node->left);
+            update(node);
+            b = node;
+        }
+    }
+
+    static Node* clone(Node *node) {
+        if (node == NULL) return NULL;
+        Node *res = new Node(node->data, node->priority);
+        res->left = clone(node->left);
+        res->right = clone(node->right);
+        update(res);
+        return res;
+    }
+
+    static void destroy(Node *node) {
+        if (node == NULL) return;
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+
+    void setRoot(Node *node) {
+        root = node;
+        if (root != NULL) root->parent = NULL;
+    }
+
+    Node* getNode(int index) const {
+        Node *node = root;
+        while (true) {
+            int l = sizeOf(node->left);
+            if (index < l) node = node->left;
+            else if (index > l) {
+                index -= l + 1;
+                node = node->right;
+            }
+            else return node;
+        }
+    }
+
+    static Node* leftmost(Node *node) {
+        if (node == NULL) return NULL;
+        while (node->left != NULL) node = node->left;
+        return node;
+    }
+
+    static Node* successor(Node *node) {
+        if (node->right != NULL) return leftmost(node->right);
+        while (node->parent != NULL && node == node->parent->right)
+            node = node->parent;
+        return node->parent;
+    }
+
+    /**
+     * Unlinks a node by putting the join of its subtrees in its place, then
+     * fixes the sizes on the way up.
+     * O(logn)
+     */
+    void removeNode(Node *node) {
+        Node *parent = node->parent, *child = merge(node->left, node->right);
+        if (child != NULL) child->parent = parent;
+        if (parent == NULL) root = child;
+        else if (parent->left == node) parent->left = child;
+        else parent->right = child;
+        for (Node *p = parent; p != NULL; p = p->parent) p->size--;
+        delete node;
+    }
+
+    std::string toString(int x) const {
+        char s[20];
+        sprintf(s, "%d", x);
+        return std::string(s);
+    }
+
+    void checkBoundInclusive(int index) const {
+        if (index < 0 || index > size())
+            throw IndexOutOfBound("\nIndex out of Bound >>> Index: " + toString(index) + ", Size: " + toString(size()) + "\n");
+    }
+
+    void checkBoundExclusive(int index) const {
+        if (index < 0 || index >= size())
+            throw IndexOutOfBound("\nIndex out of Bound >>> Index: " + toString(index) + ", Size: " + toString(size()) + "\n");
+    }
+
+    public:
+    class ConstIterator {
+        private:
+        Node *nxt;
+
+        public:
+        void init(Node *_nxt) {
+            nxt = _nxt;
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return nxt != NULL;
+        }
+
+        /**
+         * Returns the next element in the iteration.
+         * Amortized O(1)
+         * @throw ElementNotExist
+         */
+        const E& next() {
+            if (nxt == NULL)
+                throw ElementNotExist("\nNo Such Element\n");
+            Node *last = nxt;
+            nxt = successor(nxt);
+            return last->data;
+        }
+    };
+
+    class Iterator {
+        private:
+        Node *nxt, *last;
+        TreeList *lst;
+
+        public:
+        void init(TreeList *_lst, Node *_nxt) {
+            lst = _lst; nxt = _nxt; last = NULL;
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return nxt != NULL;
+        }
+
+        /**
+         * Returns the next element in the iteration.
+         * Amortized O(1)
+         * @throw ElementNotExist
+         */
+        E& next() {
+            if (nxt == NULL)
+                throw ElementNotExist("\nNo Such Element\n");
+            last = nxt;
+            nxt = successor(nxt);
+            return last->data;
+        }
+
+        /**
+         * Removes from the underlying collection the last element returned by the iterator (optional operation).
+         * O(logn)
+         * @throw ElementNotExist
+         */
+        void remove() {
+            if (last == NULL)
+                throw ElementNotExist("\nIllegal State\n");
+            lst->removeNode(last);
+            last = NULL;
+        }
+    };
+
+    /**
+     * Constructs an empty list.
+     */
+    TreeList(): root(NULL), seed(initialSeed()) {}
+
+    /**
+     * Constructs a list containing the elements of the specified collection, in
+     * the order they are returned by the collection's iterator.
+     */
+    template <class E2>
+    explicit TreeList(const E2& x): root(NULL), seed(initialSeed()) {
+        addAll(*this, x);
+    }
+
+    /**
+     * Copy-constructor
+     * O(n)
+     */
+    TreeList(const TreeList& x): root(NULL), seed(initialSeed()) {
+        setRoot(clone(x.root));
+    }
+
+    /**
+     * Assignment operator
+     * O(n)
+     */
+    TreeList& operator = (const TreeList& x) {
+        if (this == &x) return *this;
+        clear();
+        setRoot(clone(x.root));
+        return *this;
+    }
+
+    /**
+     * Destructor
+     */
+    ~TreeList() {
+        clear();
+    }
+
+    /**
+     * Returns an iterator over the elements in this list in proper sequence.
+     */
+    Iterator iterator() {
+        Iterator Itr;
+        Itr.init(this, leftmost(root));
+        return Itr;
+    }
+
+    /**
+     * Returns an CONST iterator over the elements in this list in proper sequence.
+     */
+    ConstIterator constIterator() const {
+        ConstIterator CItr;
+        CItr.init(leftmost(root));
+        return CItr;
+    }
+
+    /**
+     * Appends the specified element to the end of this list.
+     * O(logn)
+     */
+    bool add(const E& e) {
+        setRoot(merge(root, new Node(e, nextPriority())));
+        return true;
+    }
+
+    /**
+     * Inserts the specified element at the specified position in this list.
+     * The range of index is [0, size].
+     * O(logn)
+     * @throw IndexOutOfBound
+     */
+    void add(int index, const E& element) {
+        checkBoundInclusive(index);
+        Node *a, *b;
+        split(root, index, a, b);
+        setRoot(merge(merge(a, new Node(element, nextPriority())), b));
+    }
+
+    /**
+     * Removes all of the elements from this list.
+     * O(n)
+     */
+    void clear() {
+        destroy(root);
+        root = NULL;
+    }
+
+    /**
+     * Returns true if this list contains the specified element.
+     * O(n)
+     */
+    bool contains(const E& e) const {
+        return indexOf(e) != -1;
+    }
+
+    /**
+     * Returns a reference to the element at the specified position in this list.
+     * O(logn)
+     * @throw IndexOutOfBound
+     */
+    E& get(int index) {
+        checkBoundExclusive(index);
+        return getNode(index)->data;
+    }
+
+    /**
+     * Returns a const reference to the element at the specified position in this list.
+     * O(logn)
+     * @throw IndexOutOfBound
+     */
+    const E& get(int index) const {
+        checkBoundExclusive(index);
+        return getNode(index)->data;
+    }
+
+    /**
+     * Returns the index of the first occurrence of the specified element in this list, or -1 if this list does not contain the element.
+     * O(n)
+     */
+    int indexOf(const E& e) const {
+        int index = 0;
+        for (Node *node = leftmost(root); node != NULL; node = successor(node), ++index)
+            if (e == node->data) return index;
+        return -1;
+    }
+
+    /**
+     * Returns true if this list contains no elements.
+     * O(1)
+     */
+    bool isEmpty() const {
+        return root == NULL;
+    }
+
+    /**
+     * Returns the index of the last occurrence of the specified element in this list, or -1 if this list does not contain the element.
+     * O(n)
+     */
+    int lastIndexOf(const E& e) const {
+        int index = 0, res = -1;
+        for (Node *node = leftmost(root); node != NULL; node = successor(node), ++index)
+            if (e == node->data) res = index;
+        return res;
+    }
+
+    /**
+     * Removes the element at the specified position in this list.
+     * Returns the element that was removed from the list.
+     * O(logn)
+     * @throw IndexOutOfBound
+     */
+    E removeIndex(int index) {
+        checkBoundExclusive(index);
+        Node *node = getNode(index);
+        E r = node->data;
+        removeNode(node);
+        return r;
+    }
+
+    /**
+     * Removes the first occurrence of the specified element from this list, if it is present.
+     * O(n)
+     */
+    bool remove(const E& e) {
+        for (Node *node = leftmost(root); node != NULL; node = successor(node))
+            if (e == node->data) {
+                removeNode(node);
+                return true;
+            }
+        return false;
+    }
+
+    /**
+     * Removes from this list all of the elements whose index is between fromIndex, inclusive, and toIndex, exclusive.
+     * O(logn + toIndex - fromIndex)
+     * @throw IndexOutOfBound
+     */
+    void removeRange(int fromIndex, int toIndex) {
+        checkBoundExclusive(fromIndex);
+        checkBoundInclusive(toIndex);
+        if (toIndex < fromIndex)
+            throw IndexOutOfBound("\nIllegal Segment\n");
+        Node *a, *b, *c;
+        split(root, toIndex, b, c);
+        split(b, fromIndex, a, b);
+        destroy(b);
+        setRoot(merge(a, c));
+    }
+
+    /**
+     * Replaces the element at the specified position in this list with the specified element.
+     * Returns the element previously at the specified position.
+     * O(logn)
+     * @throw IndexOutOfBound
+     */
+    E set(int index, const E& element) {
+        checkBoundExclusive(index);
+        Node *node = getNode(index);
+        E r = node->data;
+        node->data = element;
+        return r;
+    }
+
+    /**
+     * Returns the number of elements in this list.
+     * O(1)
+     */
+    int size() const {
+        return sizeOf(root);
+    }
+
+    /**
+     * Returns a view of the portion of this list between the specified fromIndex, inclusive, and toIndex, exclusive.
+     * The range is split off, copied as a whole subtree and joined back.
+     * O(logn + toIndex - fromIndex)
+     * @throw IndexOutOfBound
+     */
+    TreeList subList(int fromIndex, int toIndex) {
+        checkBoundExclusive(fromIndex);
+        checkBoundInclusive(toIndex);
+        if (toIndex < fromIndex)
+            throw IndexOutOfBound("\nIllegal Segment\n");
+        Node *a, *b, *c;
+        split(root, toIndex, b, c);
+        split(b, fromIndex, a, b);
+        TreeList res;
+        res.setRoot(clone(b));
+        setRoot(merge(merge(a, b), c));
+        return res;
+    }
+
+    /**
+     * Moves the elements from the specified position to the end into rest,
+     * which is cleared first. No element is copied.
+     * O(logn)
+     * @throw IndexOutOfBound
+     */
+    void splitAt(int index, TreeList &rest) {
+        checkBoundInclusive(index);
+        if (&rest == this) return;
+        rest.clear();
+        Node *a, *b;
+        split(root, index, a, b);
+        setRoot(a);
+        rest.setRoot(b);
+    }
+
+    /**
+     * Moves all elements of c to the end of this list, leaving c empty.
+     * No element is copied.
+     * O(logn)
+     */
+    void concat(TreeList &c) {
+        if (&c == this) return;
+        setRoot(merge(root, c.root));
+        c.root = NULL;
+    }
+};
+#endif
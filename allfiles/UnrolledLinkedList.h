@@ -0,0 +1,600 @@
+/** @file */
+#ifndef __UNROLLEDLINKEDLIST_H
+#define __UNROLLEDLINKEDLIST_H
+
+#include "Utility.h"
+#include<cstdio>
+
+/**
+ * An unrolled linked list, with the same interface as LinkedList.
+ *
+ * Every node (chunk) holds up to CHUNK_CAPACITY elements in an array of
+ * about two cache lines, so walking to an index hops over whole chunks and
+ * the per-element overhead of two pointers and one allocation is shared by
+ * the elements of a chunk. A full chunk is split in halves on insertion, and
+ * a chunk that drops under half full absorbs its successor when they fit.
+ *
+ * Vacated slots are reset to T(), so removed elements hold no resources.
+ * Up to POOL_CAPACITY emptied chunks are kept for reuse; the others, and
+ * the pooled ones on trimToSize(), are freed.
+ *
+ * The iterator iterates in the order of the elements being loaded into this list.
+ */
+template <class T> class UnrolledLinkedList {
+    public:
+    static const int CHUNK_CAPACITY = 128 / sizeof(T) > 4 ? 128 / sizeof(T) : 4;
+    static const int POOL_CAPACITY = 8;
+    private:
+    class Chunk {
+        public:
+        T items[CHUNK_CAPACITY];
+        int count;
+        Chunk *next, *previous;
+        Chunk(): count(0), next(NULL), previous(NULL) {}
+    };
+    Chunk *first, *last, *pool;
+    int sz, poolSz;
+
+    Chunk* newChunk() {
+        if (pool == NULL) return new Chunk;
+        Chunk *c = pool;
+        pool = pool->next;
+        poolSz--;
+        c->count = 0;
+        c->next = c->previous = NULL;
+        return c;
+    }
+
+    /**
+     * Resets the slots of c to T() and pools it, or frees it if the pool
+     * is full.
+     */
+    void freeChunk(Chunk *c) {
+        for (int i = 0; i < c->count; ++i)
+            c->items[i] = T();
+        if (poolSz == POOL_CAPACITY) {
+            delete c;
+            return;
+        }
+        c->next = pool;
+        pool = c;
+        poolSz++;
+    }
+
+    /**
+     * Links c after the chunk pos, or in front of the list if pos is NULL.
+     */
+    void linkAfter(Chunk *pos, Chunk *c) {
+        c->previous = pos;
+        c->next = pos == NULL ? first : pos->next;
+        if (c->next != NULL) c->next->previous = c;
+        else last = c;
+        if (pos != NULL) pos->next = c;
+        else first = c;
+    }
+
+    void unlink(Chunk *c) {
+        if (c->previous != NULL) c->previous->next = c->next;
+        else first = c->next;
+        if (c->next != NULL) c->next->previous = c->previous;
+        else last = c->previous;
+        freeChunk(c);
+    }
+
+    /**
+     * Finds the chunk holding the n-th element, walking from the nearer end.
+     */
+    Chunk* locate(int n, int &offset) const {
+        Chunk *c;
+        if (n < sz / 2) {
+            c = first;
+            while (n >= c->count) {
+                n -= c->count;
+                c = c->next;
+            }
+            offset = n;
+        }
+        else {
+            c = last;
+            n = sz - 1 - n;
+            while (n >= c->count) {
+                n -= c->count;
+                c = c->previous;
+            }
+            offset = c->count - 1 - n;
+        }
+        return c;
+    }
+
+    /**
+     * Inserts elem at position off of chunk c, splitting c if it is full.
+     */
+    void insertAt(Chunk *c, int off, const T& elem) {
+        if (c->count == CHUNK_CAPACITY) {
+            Chunk *n = newChunk();
+            int half = CHUNK_CAPACITY / 2;
+            for (int i = half; i < CHUNK_CAPACITY; ++i) {
+                n->items[i - half] = c->items[i];
+                c->items[i] = T();
+            }
+            n->count = CHUNK_CAPACITY - half;
+            c->count = half;
+            linkAfter(c, n);
+            if (off > half) {
+                c = n;
+                off -= half;
+            }
+        }
+        for (int i = c->count; i > off; --i)
+            c->items[i] = c->items[i - 1];
+        c->items[off] = elem;
+        c->count++;
+        sz++;
+    }
+
+    /**
+     * Removes the element at position off of chunk c, and reports where the
+     * element that followed it is now, as (nc, noff), nc being NULL at the end.
+     */
+    void removeAt(Chunk *c, int off, Chunk *&nc, int &noff) {
+        for (int i = off + 1; i < c->count; ++i)
+            c->items[i - 1] = c->items[i];
+        c->count--;
+        c->items[c->count] = T();
+        sz--;
+        nc = c; noff = off;
+        if (c->count == 0) {
+            nc = c->next; noff = 0;
+            unlink(c);
+            return;
+        }
+        Chunk *n = c->next;
+        if (c->count < CHUNK_CAPACITY / 2 && n != NULL && c->count + n->count <= CHUNK_CAPACITY) {
+            for (int i = 0; i < n->count; ++i)
+                c->items[c->count + i] = n->items[i];
+            c->count += n->count;
+            unlink(n);
+        }
+        if (noff == c->count) {
+            nc = c->next; noff = 0;
+        }
+    }
+
+    std::string toString(int x) const {
+        char s[20];
+        sprintf(s, "%d", x);
+        return std::string(s);
+    }
+
+    void checkBoundInclusive(int index) const {
+        if (index < 0 || index > sz)
+            throw IndexOutOfBound("\nIndex out of Bound >>> Index: " + toString(index) + ", Size: " + toString(sz) + "\n");
+    }
+
+    void checkBoundExclusive(int index) const {
+        if (index < 0 || index >= sz)
+            throw IndexOutOfBound("\nIndex out of Bound >>> Index: " + toString(index) + ", Size: " + toString(sz) + "\n");
+    }
+
+    public:
+    class ConstIterator {
+        private:
+        Chunk *cnt;
+        int off;
+
+        public:
+        void init(Chunk* _cnt) {
+            cnt = _cnt; off = 0;
+        }
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return (cnt != NULL);
+        }
+
+        /**
+         * Returns the next element in the iteration.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        T& next() {
+            if (cnt == NULL)
+                throw ElementNotExist("\nNo Such Element\n");
+            T &res = cnt->items[off];
+            if (++off == cnt->count) {
+                cnt = cnt->next;
+                off = 0;
+            }
+            return res;
+        }
+    };
+
+    class Iterator {
+        private:
+        UnrolledLinkedList *lnk;
+        Chunk *cnt, *lastRet;
+        int off, lastOff;
+
+        public:
+        void init(Chunk* _cnt, UnrolledLinkedList* _lnk) {
+            cnt = _cnt; lnk = _lnk; lastRet = NULL; off = 0;
+        }
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return (cnt != NULL);
+        }
+
+        /**
+         * Returns the next element in the iteration.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        T& next() {
+            if (cnt == NULL)
+                throw ElementNotExist("\nNo Such Element\n");
+            lastRet = cnt; lastOff = off;
+            if (++off == cnt->count) {
+                cnt = cnt->next;
+                off = 0;
+            }
+            return lastRet->items[lastOff];
+        }
+
+        /**
+         * Removes from the underlying collection the last element returned by the iterator (optional operation).
+         * O(CHUNK_CAPACITY)
+         * @throw ElementNotExist
+         */
+        void remove() {
+            if (lastRet == NULL)
+                throw ElementNotExist("\nNo such Element\n");
+            lnk->removeAt(lastRet, lastOff, cnt, off);
+            lastRet = NULL;
+        }
+    };
+
+    void init() {
+        sz = 0;
+        first = last = pool = NULL;
+        poolSz = 0;
+    }
+
+    /**
+     * Constructs an empty list
+     */
+    UnrolledLinkedList() {
+        init();
+    }
+
+    /**
+     * Copy constructor
+     */
+    UnrolledLinkedList(const UnrolledLinkedList<T> &c) {
+        init();
+        addAll(*this, c);
+    }
+
+    /**
+     * Assignment operator
+     */
+    UnrolledLinkedList<T>& operator = (const UnrolledLinkedList<T> &c) {
+        if (this == &c) return *this;
+        clear();
+        addAll(*this, c);
+        return *this;
+    }
+
+    /**
+     * Constructs a list containing the elements of the specified
+     * collection, in the order they are returned by the collection's
+     * const iterator.
+     */
+    template <class C> UnrolledLinkedList(const C& c) {
+        init();
+        addAll(*this, c);
+    }
+
+    /**
+     * Desturctor
+     */
+    ~UnrolledLinkedList() {
+        clear();
+        trimToSize();
+    }
+
+    /**
+     * Inserts the specified element at the specified position in
+     * this list.
+     * O(n / CHUNK_CAPACITY + CHUNK_CAPACITY)
+     * @throw IndexOutOfBound exception when index is out of bound
+     */
+    void add(int index, const T& elem) {
+        checkBoundInclusive(index);
+        if (index == sz) {
+            add(elem);
+            return;
+        }
+        int off;
+        Chunk *c = locate(index, off);
+        insertAt(c, off, elem);
+    }
+
+    /**
+     * Appends the specified element to the end of this list.
+     * O(1).
+     * Always returns true;
+     */
+    bool add(const T& elem) {
+        if (last == NULL || last->count == CHUNK_CAPACITY) linkAfter(last, newChunk());
+        last->items[last->count++] = elem;
+        sz++;
+        return true;
+    }
+
+    /**
+     * Inserts the specified element at the beginning of this list.
+     * O(CHUNK_CAPACITY).
+     */
+    void addFirst(const T& elem) {
+        if (first == NULL || first->count == CHUNK_CAPACITY) linkAfter(NULL, newChunk());
+        insertAt(first, 0, elem);
+    }
+
+    /**
+     * Removes all of the elements from this list.
+     * The chunks are moved to the pool, or freed once it is full.
+     * O(n).
+     */
+    void clear() {
+        if (sz == 0) return;
+        for (Chunk *c = first, *n; c != NULL; c = n) {
+            n = c->next;
+            freeChunk(c);
+        }
+        first = last = NULL;
+        sz = 0;
+    }
+
+    /**
+     * Frees the chunks kept in the pool for reuse.
+     * O(number of pooled chunks).
+     */
+    void trimToSize() {
+        while (pool != NULL) {
+            Chunk *c = pool;
+            pool = pool->next;
+            delete c;
+        }
+        poolSz = 0;
+    }
+
+    /**
+     * Returns true if this list contains the specified element.
+     * O(n).
+     */
+    bool contains(const T& elem) const {
+        return indexOf(elem) != -1;
+    }
+
+    /**
+     * Returns a reference to the element at the specified position.
+     * O(n / CHUNK_CAPACITY).
+     * @throw IndexOutOfBound exception when index is out of bound
+     */
+    T& get(int index) {
+        checkBoundExclusive(index);
+        int off;
+        Chunk *c = locate(index, off);
+        return c->items[off];
+    }
+
+    /**
+     * Returns a const reference to the element at the specified position.
+     * O(n / CHUNK_CAPACITY).
+     * @throw IndexOutOfBound
+     */
+    const T& get(int index) const {
+        checkBoundExclusive(index);
+        int off;
+        Chunk *c = locate(index, off);
+        return c->items[off];
+    }
+
+    /**
+     * Returns a reference to the first element.
+     * O(1).
+     * @throw ElementNotExist
+     */
+    T& getFirst() {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return first->items[0];
+    }
+
+    /**
+     * Returns a const reference to the first element.
+     * O(1).
+     * @throw ElementNotExist
+     */
+    const T& getFirst() const {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return first->items[0];
+    }
+
+    /**
+     * Returns a reference to the last element.
+     * O(1).
+     * @throw ElementNotExist
+     */
+    T& getLast() {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return last->items[last->count - 1];
+    }
+
+    /**
+     * Returns a const reference to the last element.
+     * O(1).
+     * @throw ElementNotExist
+     */
+    const T& getLast() const {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return last->items[last->count - 1];
+    }
+
+    /**
+     * Returns the index of the first occurrence of the specified element
+     * in this list, or -1 if this list does not contain the element.
+     * O(n).
+     */
+    int indexOf(const T& elem) const {
+        int index = 0;
+        for (Chunk *c = first; c != NULL; c = c->next) {
+            for (int i = 0; i < c->count; ++i)
+                if (elem == c->items[i]) return index + i;
+            index += c->count;
+        }
+        return -1;
+    }
+
+    /**
+     * Returns true if this list contains no elements.
+     * O(1).
+     */
+    bool isEmpty() const {
+        return sz == 0;
+    }
+
+    /**
+     * Returns an iterator
+     * O(1).
+     */
+    Iterator iterator() {
+        Iterator Itr;
+        Itr.init(first, this);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator
+     * O(1).
+     */
+    ConstIterator constIterator() const {
+        ConstIterator CItr;
+        CItr.init(first);
+        return CItr;
+    }
+
+    /**
+     * Removes the element at the specified position in this list.
+     * O(n / CHUNK_CAPACITY + CHUNK_CAPACITY).
+     * @throw IndexOutOfBound exception when index is out of bound
+     */
+    T removeIndex(int index) {
+        checkBoundExclusive(index);
+        int off, noff;
+        Chunk *c = locate(index, off), *nc;
+        T res = c->items[off];
+        removeAt(c, off, nc, noff);
+        return res;
+    }
+
+    /**
+     * Removes the first occurrence of the specified element from this
+     * list, if it is present.
+     * O(n).
+     */
+    bool remove(const T& elem) {
+        for (Chunk *c = first; c != NULL; c = c->next)
+            for (int i = 0; i < c->count; ++i)
+                if (elem == c->items[i]) {
+                    Chunk *nc;
+                    int noff;
+                    removeAt(c, i, nc, noff);
+                    return true;
+                }
+        return false;
+    }
+
+    /**
+     * Removes and returns the first element from this list.
+     * O(CHUNK_CAPACITY).
+     * @throw ElementNotExist
+     */
+    T removeFirst() {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        T res = first->items[0];
+        Chunk *nc;
+        int noff;
+        removeAt(first, 0, nc, noff);
+        return res;
+    }
+
+    /**
+     * Removes and returns the last element from this list.
+     * O(1).
+     * @throw ElementNotExist
+     */
+    T removeLast() {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        T res = last->items[last->count - 1];
+        Chunk *nc;
+        int noff;
+        removeAt(last, last->count - 1, nc, noff);
+        return res;
+    }
+
+    /**
+     * Replaces the element at the specified position in this list with
+     * the specified element.
+     * O(n / CHUNK_CAPACITY).
+     * @throw IndexOutOfBound exception when index is out of bound
+     */
+    T set(int index, const T& elem) {
+        checkBoundExclusive(index);
+        int off;
+        Chunk *c = locate(index, off);
+        T old = c->items[off];
+        c->items[off] = elem;
+        return old;
+    }
+
+    /**
+     * Returns the number of elements in this list.
+     */
+    int size() const {
+        return sz;
+    }
+
+    /**
+     * Returns a view of the portion of this list between the specified
+     * fromIndex, inclusive, and toIndex, exclusive.
+     * O(n / CHUNK_CAPACITY + toIndex - fromIndex).
+     * @throw IndexOutOfBound
+     */
+    UnrolledLinkedList<T> subList(int fromIndex, int toIndex) {
+        checkBoundExclusive(fromIndex);
+        checkBoundInclusive(toIndex);
+        int len = toIndex - fromIndex;
+        if (len >= 0) {
+            UnrolledLinkedList res;
+            int off;
+            Chunk *c = locate(fromIndex, off);
+            for (int i = 0; i < len; ++i) {
+                res.add(c->items[off]);
+                if (++off == c->count) {
+                    c = c->next;
+                    off = 0;
+                }
+            }
+            return res;
+        }
+        else {
+            throw IndexOutOfBound("\nIllegal Segment\n");
+        }
+    }
+};
+#endif
@@ -0,0 +1,941 @@
+/** @file */
+#ifndef __BPLUSTREEMAP_H
+#define __BPLUSTREEMAP_H
+
+#include "Utility.h"
+#include<new>
+
+/**
+ * A BPlusTreeMap is an ordered map with the interface of TreeMap, stored in
+ * a B+ tree instead of a red-black tree.
+ *
+ * Every node occupies about a kilobyte: an inner node holds up to INNER_CAP
+ * keys in one array, so a lookup touches O(log n / log INNER_CAP) nodes
+ * instead of O(log n), and a leaf holds up to LEAF_CAP entries contiguously.
+ * The leaves are linked in key order, so iteration reads the entries
+ * sequentially. Nodes other than the root are kept at least half full by
+ * splitting on insertion and by borrowing from or merging with a sibling on
+ * removal.
+ *
+ * Insertions and removals move entries inside and between leaves, so they
+ * invalidate references to entries and iterators, except the iterator
+ * whose remove() is called.
+ *
+ * The iterators must iterate through the map in the order defined by the
+ * comparator class C, as for TreeMap; it defaults to the natural order
+ * (operator<) of the key.
+ */
+template<class K, class V, class C = Comparator<K> > class BPlusTreeMap {
+    private:
+    static const int NODE_BYTES = 1024, MAX_HEIGHT = 32;
+    static const int LEAF_CAP = sizeof(Entry<K, V>) * 8 > NODE_BYTES ? 8 : NODE_BYTES / sizeof(Entry<K, V>);
+    static const int INNER_CAP = (sizeof(K) + sizeof(void*)) * 8 > NODE_BYTES ? 8 : NODE_BYTES / (sizeof(K) + sizeof(void*));
+    static const int LEAF_MIN = LEAF_CAP / 2, INNER_MIN = INNER_CAP / 2;
+
+    class Node {
+        public:
+        int cnt;
+        Node(): cnt(0) {}
+    };
+
+    class Inner: public Node {
+        public:
+        K keys[INNER_CAP];
+        Node *children[INNER_CAP + 1];
+    };
+
+    /**
+     * The entries are constructed in place in raw storage, since Entry has
+     * a const key and no default constructor.
+     */
+    class Leaf: public Node {
+        public:
+        Leaf *prev, *next;
+        union {
+            char raw[LEAF_CAP * sizeof(Entry<K, V>)];
+            long double alignA;
+            long long alignB;
+            void *alignC;
+        } store;
+        Leaf(): prev(NULL), next(NULL) {}
+        Entry<K, V>* at(int i) {
+            return (Entry<K, V>*)store.raw + i;
+        }
+        const Entry<K, V>* at(int i) const {
+            return (const Entry<K, V>*)store.raw + i;
+        }
+        /**
+         * Moves the entry at index from to the empty slot at index to.
+         */
+        void move(int from, Leaf *dest, int to) {
+            new (dest->at(to)) Entry<K, V>(*at(from));
+            at(from)->~Entry<K, V>();
+        }
+    };
+
+    Node *root;
+    Leaf *head, *tail;
+    int height, sz;
+
+    static int upperIndex(const Inner *node, const K& key) {
+        int lo = 0, hi = node->cnt;
+        while (lo < hi) {
+            int mid = (lo + hi) >> 1;
+            if (C::compare(key, node->keys[mid]) < 0) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo;
+    }
+
+    static int upperIndex(const Leaf *node, const K& key) {
+        int lo = 0, hi = node->cnt;
+        while (lo < hi) {
+            int mid = (lo + hi) >> 1;
+            if (C::compare(key, node->at(mid)->key) < 0) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo;
+    }
+
+    static int lowerIndex(const Leaf *node, const K& key) {
+        int lo = 0, hi = node->cnt;
+        while (lo < hi) {
+            int mid = (lo + hi) >> 1;
+            if (C::compare(node->at(mid)->key, key) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    Leaf* findLeaf(const K& key) const {
+        Node *node = root;
+        for (int h = height; h > 0; --h)
+            node = ((Inner*)node)->children[upperIndex((Inner*)node, key)];
+        return (Leaf*)node;
+    }
+
+    /**
+     * Returns the entry with the specified key, or NULL.
+     */
+    Entry<K, V>* getEntry(const K& key) const {
+        Leaf *leaf = findLeaf(key);
+        int i = lowerIndex(leaf, key);
+        if (i < leaf->cnt && C::compare(key, leaf->at(i)->key) == 0) return leaf->at(i);
+        return NULL;
+    }
+
+    /**
+     * Finds the position of the first entry whose key is greater than key,
+     * or not less than key if !strict; leaf is NULL if there is none.
+     */
+    void seek(const K& key, bool strict, Leaf *&leaf, int &idx) const {
+        leaf = findLeaf(key);
+        idx = strict ? upperIndex(leaf, key) : lowerIndex(leaf, key);
+        if (idx == leaf->cnt) {
+            leaf = leaf->next;
+            idx = 0;
+        }
+    }
+
+    /**
+     * Finds the position of the last entry whose key is less than key, or
+     * not greater than key if !strict; leaf is NULL if there is none.
+     */
+    void seekBack(const K& key, bool strict, Leaf *&leaf, int &idx) const {
+        leaf = findLeaf(key);
+        idx = (strict ? lowerIndex(leaf, key) : upperIndex(leaf, key)) - 1;
+        if (idx < 0) {
+            leaf = leaf->prev;
+            if (leaf != NULL) idx = leaf->cnt - 1;
+        }
+    }
+
+    static const Entry<K, V>& entryAt(const Leaf *leaf, int idx) {
+        if (leaf == NULL) throw ElementNotExist("\nNo Such Element\n");
+        return *leaf->at(idx);
+    }
+
+    void destroy(Node *node, int h) {
+        if (h == 0) {
+            Leaf *leaf = (Leaf*)node;
+            for (int i = 0; i < leaf->cnt; ++i) leaf->at(i)->~Entry<K, V>();
+            delete leaf;
+            return;
+        }
+        Inner *inner = (Inner*)node;
+        for (int i = 0; i <= inner->cnt; ++i) destroy(inner->children[i], h - 1);
+        delete inner;
+    }
+
+    /**
+     * Copies the subtree of height h rooted at src, appending its leaves
+     * to the leaf list.
+     */
+    Node* clone(const Node *src, int h) {
+        if (h == 0) {
+            const Leaf *from = (const Leaf*)src;
+            Leaf *leaf = new Leaf;
+            for (int i = 0; i < from->cnt; ++i) new (leaf->at(i)) Entry<K, V>(*from->at(i));
+            leaf->cnt = from->cnt;
+            leaf->prev = tail;
+            if (tail != NULL) tail->next = leaf;
+            else head = leaf;
+            tail = leaf;
+            return leaf;
+        }
+        const Inner *from = (const Inner*)src;
+        Inner *inner = new Inner;
+        for (int i = 0; i < from->cnt; ++i) inner->keys[i] = from->keys[i];
+        for (int i = 0; i <= from->cnt; ++i) inner->children[i] = clone(from->children[i], h - 1);
+        inner->cnt = from->cnt;
+        return inner;
+    }
+
+    void init() {
+        root = head = tail = new Leaf;
+        height = sz = 0;
+    }
+
+    void copyFrom(const BPlusTreeMap &c) {
+        head = tail = NULL;
+        root = clone(c.root, c.height);
+        height = c.height;
+        sz = c.sz;
+    }
+
+    /**
+     * Inserts key and the child right of it at position pos of the inner
+     * node on level level of path, splitting full nodes up to the root.
+     */
+    void insertInner(Inner **path, int *pos, int level, K key, Node *child) {
+        while (level >= 0) {
+            Inner *node = path[level];
+            int p = pos[level];
+            if (node->cnt < INNER_CAP) {
+                for (int i = node->cnt; i > p; --i) {
+                    node->keys[i] = node->keys[i - 1];
+                    node->children[i + 1] = node->children[i];
+                }
+                node->keys[p] = key;
+                node->children[p + 1] = child;
+                node->cnt++;
+                return;
+            }
+            int mid = node->cnt / 2;
+            Inner *right = new Inner;
+            right->cnt = node->cnt - mid - 1;
+            for (int i = 0; i < right->cnt; ++i) {
+                right->keys[i] = node->keys[mid + 1 + i];
+                right->children[i] = node->children[mid + 1 + i];
+            }
+            right->children[right->cnt] = node->children[node->cnt];
+            K up = node->keys[mid];
+            node->cnt = mid;
+            Inner *target = node;
+            if (p > mid) {
+                target = right;
+                p -= mid + 1;
+            }
+            for (int i = target->cnt; i > p; --i) {
+                target->keys[i] = target->keys[i - 1];
+                target->children[i + 1] = target->children[i];
+            }
+            target->keys[p] = key;
+            target->children[p + 1] = child;
+            target->cnt++;
+            key = up;
+            child = right;
+            level--;
+        }
+        Inner *newRoot = new Inner;
+        newRoot->cnt = 1;
+        newRoot->keys[0] = key;
+        newRoot->children[0] = root;
+        newRoot->children[1] = child;
+        root = newRoot;
+        height++;
+    }
+
+    /**
+     * Refills the inner node on level level of path, which has fewer than
+     * INNER_MIN keys, from a sibling, merging the two if the sibling has no
+     * key to spare; goes on upwards while merges leave the parent short.
+     */
+    void fixInner(Inner **path, int *pos, int level) {
+        while (level > 0) {
+            Inner *node = path[level], *parent = path[level - 1];
+            if (node->cnt >= INNER_MIN) return;
+            int p = pos[level - 1];
+            if (p > 0 && ((Inner*)parent->children[p - 1])->cnt > INNER_MIN) {
+                Inner *left = (Inner*)parent->children[p - 1];
+                for (int i = node->cnt; i > 0; --i) node->keys[i] = node->keys[i - 1];
+                for (int i = node->cnt + 1; i > 0; --i) node->children[i] = node->children[i - 1];
+                node->keys[0] = parent->keys[p - 1];
+                node->children[0] = left->children[left->cnt];
+                parent->keys[p - 1] = left->keys[left->cnt - 1];
+                left->cnt--;
+                node->cnt++;
+                return;
+            }
+            if (p < parent->cnt && ((Inner*)parent->children[p + 1])->cnt > INNER_MIN) {
+                Inner *right = (Inner*)parent->children[p + 1];
+                node->keys[node->cnt] = parent->keys[p];
+                node->children[node->cnt + 1] = right->children[0];
+                parent->keys[p] = right->keys[0];
+                for (int i = 0; i < right->cnt - 1; ++i) right->keys[i] = right->keys[i + 1];
+                for (int i = 0; i < right->cnt; ++i) right->children[i] = right->children[i + 1];
+                right->cnt--;
+                node->cnt++;
+                return;
+            }
+            int sep = p > 0 ? p - 1 : p;
+            Inner *left = (Inner*)parent->children[sep], *right = (Inner*)parent->children[sep + 1];
+            left->keys[left->cnt] = parent->keys[sep];
+            for (int i = 0; i < right->cnt; ++i) left->keys[left->cnt + 1 + i] = right->keys[i];
+            for (int i = 0; i <= right->cnt; ++i) left->children[left->cnt + 1 + i] = right->children[i];
+            left->cnt += right->cnt + 1;
+            delete right;
+            removeFromInner(parent, sep);
+            level--;
+        }
+        shrinkRoot();
+    }
+
+    /**
+     * Removes the key at index sep and the child right of it.
+     */
+    static void removeFromInner(Inner *node, int sep) {
+        for (int i = sep; i < node->cnt - 1; ++i) {
+            node->keys[i] = node->keys[i + 1];
+            node->children[i + 1] = node->children[i + 2];
+        }
+        node->cnt--;
+    }
+
+    void shrinkRoot() {
+        if (height > 0 && root->cnt == 0) {
+            Inner *old = (Inner*)root;
+            root = old->children[0];
+            delete old;
+            height--;
+        }
+    }
+
+    /**
+     * Refills the leaf, which has fewer than LEAF_MIN entries, from a
+     * sibling under the same parent, or merges the two.
+     */
+    void fixLeaf(Leaf *leaf, Inner **path, int *pos) {
+        Inner *parent = path[height - 1];
+        int p = pos[height - 1];
+        if (p > 0 && parent->children[p - 1]->cnt > LEAF_MIN) {
+            Leaf *left = (Leaf*)parent->children[p - 1];
+            for (int i = leaf->cnt; i > 0; --i) leaf->move(i - 1, leaf, i);
+            left->move(left->cnt - 1, leaf, 0);
+            left->cnt--;
+            leaf->cnt++;
+            parent->keys[p - 1] = leaf->at(0)->key;
+            return;
+        }
+        if (p < parent->cnt && parent->children[p + 1]->cnt > LEAF_MIN) {
+            Leaf *right = (Leaf*)parent->children[p + 1];
+            right->move(0, leaf, leaf->cnt);
+            for (int i = 0; i < right->cnt - 1; ++i) right->move(i + 1, right, i);
+            right->cnt--;
+            leaf->cnt++;
+            parent->keys[p] = right->at(0)->key;
+            return;
+        }
+        int sep = p > 0 ? p - 1 : p;
+        Leaf *left = (Leaf*)parent->children[sep], *right = (Leaf*)parent->children[sep + 1];
+        for (int i = 0; i < right->cnt; ++i) right->move(i, left, left->cnt + i);
+        left->cnt += right->cnt;
+        left->next = right->next;
+        if (right->next != NULL) right->next->prev = left;
+        else tail = left;
+        delete right;
+        removeFromInner(parent, sep);
+        fixInner(path, pos, height - 1);
+    }
+
+    public:
+    class ConstIterator {
+        private:
+            const Leaf *leaf;
+            int idx;
+            bool hasHi;
+            /**
+             * The exclusive upper bound of a SubMap iterator, if hasHi.
+             */
+            K hi;
+        public:
+        void init(const Leaf *_leaf, int _idx) {
+            leaf = _leaf; idx = _idx;
+            if (leaf != NULL && leaf->cnt == 0) leaf = NULL;
+            hasHi = false;
+        }
+        void init(const Leaf *_leaf, int _idx, const K& _hi) {
+            init(_leaf, _idx);
+            hasHi = true; hi = _hi;
+        }
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1).
+         */
+        bool hasNext() {
+            return leaf != NULL && (!hasHi || C::compare(leaf->at(idx)->key, hi) < 0);
+        }
+
+        /**
+         * Returns a reference to the next element in the iteration.
+         * O(1).
+         * @throw ElementNotExist
+         */
+        const Entry<K, V>& next() {
+            if (!hasNext()) throw ElementNotExist("\nNo Such Element\n");
+            const Entry<K, V> *e = leaf->at(idx);
+            if (++idx == leaf->cnt) {
+                leaf = leaf->next;
+                idx = 0;
+            }
+            return *e;
+        }
+    };
+
+    class Iterator {
+        private:
+            Leaf *leaf;
+            int idx;
+            bool canRemove, hasHi;
+            BPlusTreeMap *treeM;
+            /**
+             * The exclusive upper bound of a SubMap iterator, if hasHi.
+             */
+            K hi;
+        public:
+        void init(Leaf *_leaf, int _idx, BPlusTreeMap *_treeM) {
+            leaf = _leaf; idx = _idx; treeM = _treeM;
+            if (leaf != NULL && leaf->cnt == 0) leaf = NULL;
+            canRemove = hasHi = false;
+        }
+        void init(Leaf *_leaf, int _idx, BPlusTreeMap *_treeM, const K& _hi) {
+            init(_leaf, _idx, _treeM);
+            hasHi = true; hi = _hi;
+        }
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1).
+         */
+        bool hasNext() {
+            return leaf != NULL && (!hasHi || C::compare(leaf->at(idx)->key, hi) < 0);
+        }
+
+        /**
+         * Returns a reference to the next element in the iteration.
+         * O(1).
+         * @throw ElementNotExist
+         */
+        Entry<K, V>& next() {
+            if (!hasNext()) throw ElementNotExist("\nNo Such Element\n");
+            Entry<K, V> *e = leaf->at(idx);
+            if (++idx == leaf->cnt) {
+                leaf = leaf->next;
+                idx = 0;
+            }
+            canRemove = true;
+            return *e;
+        }
+
+        /**
+         * Removes from the underlying collection the last element
+         * returned by the iterator. The entries may move, so the iterator
+         * finds its place again by key.
+         * O(logn).
+         * @throw ElementNotExist
+         */
+        void remove() {
+            if (!canRemove) throw ElementNotExist("\nIllegal State\n");
+            const Leaf *prevLeaf = idx > 0 ? leaf : (leaf != NULL ? leaf->prev : treeM->tail);
+            int prevIdx = idx > 0 ? idx - 1 : prevLeaf->cnt - 1;
+            K key = prevLeaf->at(prevIdx)->key;
+            treeM->remove(key);
+            treeM->seek(key, false, leaf, idx);
+            canRemove = false;
+        }
+    };
+
+    /**
+     * A view of the mappings whose keys range from an inclusive lower bound
+     * to an exclusive upper bound, either of which may be absent, as for
+     * TreeMap. The iterators seek the lower bound in O(logn) and compare
+     * every key with the upper bound. A range whose lower bound is above
+     * its upper bound is empty.
+     */
+    class SubMap {
+        public:
+        typedef typename BPlusTreeMap<K, V, C>::ConstIterator ConstIterator;
+        typedef typename BPlusTreeMap<K, V, C>::Iterator Iterator;
+
+        private:
+        BPlusTreeMap *treeM;
+        K lo, hi;
+        bool hasLo, hasHi;
+
+        void start(Leaf *&leaf, int &idx) const {
+            if (hasLo) treeM->seek(lo, false, leaf, idx);
+            else {
+                leaf = treeM->head;
+                idx = 0;
+            }
+        }
+
+        bool inRange(const K& key) const {
+            return (!hasLo || C::compare(key, lo) >= 0) && (!hasHi || C::compare(key, hi) < 0);
+        }
+
+        public:
+        SubMap(BPlusTreeMap *_treeM, const K& _lo, bool _hasLo, const K& _hi, bool _hasHi):
+            treeM(_treeM), lo(_lo), hi(_hi), hasLo(_hasLo), hasHi(_hasHi) {}
+
+        /**
+         * Returns an iterator over the mappings in this view.
+         * O(logn).
+         */
+        Iterator iterator() {
+            Leaf *leaf;
+            int idx;
+            start(leaf, idx);
+            Iterator Itr;
+            if (hasHi) Itr.init(leaf, idx, treeM, hi);
+            else Itr.init(leaf, idx, treeM);
+            return Itr;
+        }
+
+        /**
+         * Returns an const iterator over the mappings in this view.
+         * O(logn).
+         */
+        ConstIterator constIterator() const {
+            Leaf *leaf;
+            int idx;
+            start(leaf, idx);
+            ConstIterator CItr;
+            if (hasHi) CItr.init(leaf, idx, hi);
+            else CItr.init(leaf, idx);
+            return CItr;
+        }
+
+        /**
+         * Returns true if the key lies in the range and is in the map.
+         * O(logn).
+         */
+        bool containsKey(const K& key) const {
+            return inRange(key) && treeM->containsKey(key);
+        }
+
+        /**
+         * Returns a reference to the value which the specified key is mapped
+         * O(logn).
+         * @throw ElementNotExist
+         */
+        V& get(const K& key) {
+            if (!inRange(key)) throw ElementNotExist("\nNo Such Element\n");
+            return treeM->get(key);
+        }
+
+        /**
+         * Returns true if no key of the map lies in the range.
+         * O(logn).
+         */
+        bool isEmpty() const {
+            return !constIterator().hasNext();
+        }
+
+        /**
+         * Returns the number of mappings in this view.
+         * O(logn + k), k being the result.
+         */
+        int size() const {
+            int cnt = 0;
+            for (ConstIterator CItr = constIterator(); CItr.hasNext(); CItr.next())
+                cnt++;
+            return cnt;
+        }
+    };
+
+    /**
+     * Constructs an empty map
+     */
+    BPlusTreeMap() {
+        init();
+    }
+
+    /**
+     * Copy constructor, copying the tree node by node.
+     * O(n).
+     */
+    BPlusTreeMap(const BPlusTreeMap &c) {
+        copyFrom(c);
+    }
+
+    /**
+     * Destructor
+     */
+    ~BPlusTreeMap() {
+        destroy(root, height);
+    }
+
+    /**
+     * Assignment operator, copying the tree node by node.
+     * O(n).
+     */
+    BPlusTreeMap& operator=(const BPlusTreeMap &c) {
+        if (this == &c) return *this;
+        destroy(root, height);
+        copyFrom(c);
+        return *this;
+    }
+
+    /**
+     * Constructs a new map containing the same mappings as the given map
+     */
+    template <class M> explicit BPlusTreeMap(const M& m) {
+        init();
+        addAll(*this, m);
+    }
+
+    /**
+     * Returns an iterator over the elements in this map.
+     * O(1).
+     */
+    Iterator iterator() {
+        Iterator Itr;
+        Itr.init(head, 0, this);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator over the elements in this map.
+     * O(1).
+     */
+    ConstIterator constIterator() const {
+        ConstIterator CItr;
+        CItr.init(head, 0);
+        return CItr;
+    }
+
+    /**
+     * Returns an iterator starting at the first mapping whose key is not
+     * less than key.
+     * O(logn).
+     */
+    Iterator lowerBound(const K& key) {
+        Leaf *leaf;
+        int idx;
+        seek(key, false, leaf, idx);
+        Iterator Itr;
+        Itr.init(leaf, idx, this);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator starting at the first mapping whose key is
+     * not less than key.
+     * O(logn).
+     */
+    ConstIterator lowerBound(const K& key) const {
+        Leaf *leaf;
+        int idx;
+        seek(key, false, leaf, idx);
+        ConstIterator CItr;
+        CItr.init(leaf, idx);
+        return CItr;
+    }
+
+    /**
+     * Returns an iterator starting at the first mapping whose key is
+     * greater than key.
+     * O(logn).
+     */
+    Iterator upperBound(const K& key) {
+        Leaf *leaf;
+        int idx;
+        seek(key, true, leaf, idx);
+        Iterator Itr;
+        Itr.init(leaf, idx, this);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator starting at the first mapping whose key is
+     * greater than key.
+     * O(logn).
+     */
+    ConstIterator upperBound(const K& key) const {
+        Leaf *leaf;
+        int idx;
+        seek(key, true, leaf, idx);
+        ConstIterator CItr;
+        CItr.init(leaf, idx);
+        return CItr;
+    }
+
+    /**
+     * Returns the mapping with the least key greater than or equal to key.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& ceilingEntry(const K& key) const {
+        Leaf *leaf;
+        int idx;
+        seek(key, false, leaf, idx);
+        return entryAt(leaf, idx);
+    }
+
+    /**
+     * Returns the mapping with the greatest key less than or equal to key.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& floorEntry(const K& key) const {
+        Leaf *leaf;
+        int idx;
+        seekBack(key, false, leaf, idx);
+        return entryAt(leaf, idx);
+    }
+
+    /**
+     * Returns the mapping with the least key strictly greater than key.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& higherEntry(const K& key) const {
+        Leaf *leaf;
+        int idx;
+        seek(key, true, leaf, idx);
+        return entryAt(leaf, idx);
+    }
+
+    /**
+     * Returns the mapping with the greatest key strictly less than key.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& lowerEntry(const K& key) const {
+        Leaf *leaf;
+        int idx;
+        seekBack(key, true, leaf, idx);
+        return entryAt(leaf, idx);
+    }
+
+    /**
+     * Returns a view of the mappings whose keys range from fromKey,
+     * inclusive, to toKey, exclusive.
+     * O(1).
+     */
+    SubMap subMap(const K& fromKey, const K& toKey) {
+        return SubMap(this, fromKey, true, toKey, true);
+    }
+
+    /**
+     * Returns a view of the mappings whose keys are less than toKey.
+     * O(1).
+     */
+    SubMap headMap(const K& toKey) {
+        return SubMap(this, toKey, false, toKey, true);
+    }
+
+    /**
+     * Returns a view of the mappings whose keys are greater than or equal
+     * to fromKey.
+     * O(1).
+     */
+    SubMap tailMap(const K& fromKey) {
+        return SubMap(this, fromKey, true, fromKey, false);
+    }
+
+    /**
+     * Removes all of the mappings from this map.
+     * O(n).
+     */
+    void clear() {
+        destroy(root, height);
+        init();
+    }
+
+    /**
+     * Returns true if this map contains a mapping for the specified key.
+     * O(logn).
+     */
+    bool containsKey(const K& key) const {
+        return getEntry(key) != NULL;
+    }
+
+    /**
+     * Returns true if this map contains a mapping for the specified value.
+     * O(n).
+     */
+    bool containsValue(const V& value) const {
+        for (const Leaf *leaf = head; leaf != NULL; leaf = leaf->next)
+            for (int i = 0; i < leaf->cnt; ++i)
+                if (value == leaf->at(i)->value) return true;
+        return false;
+    }
+
+    /**
+     * Returns a key-value mapping associated with the least key in
+     * this map.
+     * O(1).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& firstEntry() const {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return *head->at(0);
+    }
+
+    /**
+     * Returns the first (lowest) key currently in this map.
+     * O(1).
+     * @throw ElementNotExist
+     */
+    const K& firstKey() const {
+        return firstEntry().key;
+    }
+
+    /**
+     * Returns a reference to the value which the specified key is mapped
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    V& get(const K& key) {
+        Entry<K, V> *e = getEntry(key);
+        if (e == NULL) throw ElementNotExist("\nNo Such Element\n");
+        return e->value;
+    }
+
+    /**
+     * Returns a reference to the value which the specified key is mapped
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const V& get(const K& key) const {
+        const Entry<K, V> *e = getEntry(key);
+        if (e == NULL) throw ElementNotExist("\nNo Such Element\n");
+        return e->value;
+    }
+
+    /**
+     * Returns a key-value mapping associated with the greatest key
+     * in this map.
+     * O(1).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& lastEntry() const {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return *tail->at(tail->cnt - 1);
+    }
+
+    /**
+     * Returns the last (highest) key currently in this map.
+     * O(1).
+     * @throw ElementNotExist
+     */
+    const K& lastKey() const {
+        return lastEntry().key;
+    }
+
+    void add(const Entry<K, V>& e) {
+        put(e.key, e.value);
+    }
+
+    /**
+     * Associates the specified value with the specified key in this map.
+     * Returns the previous value, if not exist, a value returned by the
+     * default-constructor.
+     * O(logn).
+     */
+    V put(const K& key, const V& value) {
+        Inner *path[MAX_HEIGHT];
+        int pos[MAX_HEIGHT];
+        Node *node = root;
+        for (int h = 0; h < height; ++h) {
+            path[h] = (Inner*)node;
+            pos[h] = upperIndex(path[h], key);
+            node = path[h]->children[pos[h]];
+        }
+        Leaf *leaf = (Leaf*)node;
+        int i = lowerIndex(leaf, key);
+        if (i < leaf->cnt && C::compare(key, leaf->at(i)->key) == 0) {
+            V res = leaf->at(i)->value;
+            leaf->at(i)->value = value;
+            return res;
+        }
+        sz++;
+        if (leaf->cnt == LEAF_CAP) {
+            Leaf *right = new Leaf;
+            int mid = LEAF_CAP / 2;
+            for (int j = mid; j < leaf->cnt; ++j) leaf->move(j, right, j - mid);
+            right->cnt = leaf->cnt - mid;
+            leaf->cnt = mid;
+            right->next = leaf->next;
+            right->prev = leaf;
+            if (leaf->next != NULL) leaf->next->prev = right;
+            else tail = right;
+            leaf->next = right;
+            if (i > mid) {
+                i -= mid;
+                leaf = right;
+            }
+            for (int j = leaf->cnt; j > i; --j) leaf->move(j - 1, leaf, j);
+            new (leaf->at(i)) Entry<K, V>(key, value);
+            leaf->cnt++;
+            insertInner(path, pos, height - 1, right->at(0)->key, right);
+        }
+        else {
+            for (int j = leaf->cnt; j > i; --j) leaf->move(j - 1, leaf, j);
+            new (leaf->at(i)) Entry<K, V>(key, value);
+            leaf->cnt++;
+        }
+        V res; return res;
+    }
+
+    /**
+     * Removes the mapping for this key from this map if present.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    V remove(const K& key) {
+        Inner *path[MAX_HEIGHT];
+        int pos[MAX_HEIGHT];
+        Node *node = root;
+        for (int h = 0; h < height; ++h) {
+            path[h] = (Inner*)node;
+            pos[h] = upperIndex(path[h], key);
+            node = path[h]->children[pos[h]];
+        }
+        Leaf *leaf = (Leaf*)node;
+        int i = lowerIndex(leaf, key);
+        if (i == leaf->cnt || C::compare(key, leaf->at(i)->key) != 0) throw ElementNotExist("\nNo Such Element\n");
+        V res = leaf->at(i)->value;
+        leaf->at(i)->~Entry<K, V>();
+        for (int j = i + 1; j < leaf->cnt; ++j) leaf->move(j, leaf, j - 1);
+        leaf->cnt--;
+        sz--;
+        if (height > 0 && leaf->cnt < LEAF_MIN) fixLeaf(leaf, path, pos);
+        return res;
+    }
+
+    bool isEmpty() const {
+        return sz == 0;
+    }
+
+    /**
+     * Returns the number of key-value mappings in this map.
+     * O(1).
+     */
+    int size() const {
+        return sz;
+    }
+};
+
+#endif
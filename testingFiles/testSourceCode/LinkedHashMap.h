@@ -0,0 +1,430 @@
+/** @file */
+#ifndef __LINKEDHASHMAP_H
+#define __LINKEDHASHMAP_H
+
+#include "Utility.h"
+#include<cstdlib>
+
+/**
+ * A LinkedHashMap is a HashMap whose entries are also threaded on a doubly
+ * linked list, so it iterates in a predictable order: the order in which
+ * keys were inserted, or, in access-order mode, from the least recently
+ * accessed entry to the most recently accessed one.
+ *
+ * In access-order mode get() and put() move the entry to the end of the list
+ * in O(1), which makes the map an LRU cache without a separate LinkedList of
+ * keys. After every insertion the map asks removeEldestEntry() whether the
+ * first entry of the list should be evicted; by default it is evicted when
+ * the map holds more than maxEntries entries (0 means unbounded). Derive
+ * from the map and override removeEldestEntry() for other policies.
+ *
+ * Template argument H is the hash class, as for HashMap. For example:
+ * @code
+ *      LinkedHashMap<int, int, Hashint> cache(1024, LinkedHashMap<int, int, Hashint>::ACCESS_ORDER);
+ * @endcode
+ * is an LRU cache holding at most 1024 mappings.
+ */
+template <class K, class V, class H>
+class LinkedHashMap {
+    public:
+    static const int DEFAULT_CAPCITY = 11;
+    static const double DEFAULT_LOAD_FACTOR = 0.75;
+    static const bool INSERTION_ORDER = false, ACCESS_ORDER = true;
+    private:
+    class Link {
+        public:
+        Link *before, *after;
+    };
+    class LinkedEntry: public Entry<K, V>, public Link {
+        public:
+        LinkedEntry *next;
+        LinkedEntry(const K& _key, const V& _value, LinkedEntry *_next):
+            Entry<K, V>(_key, _value), next(_next) {}
+    };
+    int threshold, cap;
+    double loadFactor;
+    LinkedEntry **buckets;
+    int sz, maxSize;
+    bool accessOrder;
+    /**
+     * Sentinel of the list: header.after is the eldest entry and
+     * header.before the youngest.
+     */
+    Link header;
+
+    static int getMax(int a, int b) {
+        if (a > b) return a;
+        return b;
+    }
+
+    static LinkedEntry* entryOf(Link *l) {
+        return static_cast<LinkedEntry*>(l);
+    }
+
+    int hash(const K &key) const {
+        return abs(H::hashcode(key) % cap);
+    }
+
+    void unlink(Link *l) {
+        l->before->after = l->after;
+        l->after->before = l->before;
+    }
+
+    void linkLast(Link *l) {
+        l->before = header.before;
+        l->after = &header;
+        header.before->after = l;
+        header.before = l;
+    }
+
+    void recordAccess(LinkedEntry *e) {
+        if (accessOrder && header.before != e) {
+            unlink(e);
+            linkLast(e);
+        }
+    }
+
+    LinkedEntry* getEntry(const K& key) const {
+        for (LinkedEntry *e = buckets[hash(key)]; e != NULL; e = e->next)
+            if (key == e->key) return e;
+        return NULL;
+    }
+
+    void rehash() {
+        LinkedEntry **oldBuckets = buckets;
+        cap = cap * 2 + 1;
+        threshold = (int)(cap * loadFactor);
+        buckets = new LinkedEntry*[cap];
+        for (int i = 0; i < cap; ++i) buckets[i] = NULL;
+        for (Link *l = header.after; l != &header; l = l->after) {
+            LinkedEntry *e = entryOf(l);
+            int idx = hash(e->key);
+            e->next = buckets[idx];
+            buckets[idx] = e;
+        }
+        delete [] oldBuckets;
+    }
+
+    /**
+     * Unlinks the entry from its bucket and from the list and frees it.
+     */
+    void removeEntry(LinkedEntry *e) {
+        LinkedEntry **p = &buckets[hash(e->key)];
+        while (*p != e) p = &(*p)->next;
+        *p = e->next;
+        unlink(e);
+        sz--;
+        delete e;
+    }
+
+    void getSpace() {
+        Link *l = header.after;
+        while (l != &header) {
+            Link *nxt = l->after;
+            delete entryOf(l);
+            l = nxt;
+        }
+    }
+
+    void init(int iniCap, double loadFac, bool order, int maxEntries) {
+        if (iniCap == 0) iniCap = 1;
+        cap = iniCap;
+        buckets = new LinkedEntry*[iniCap];
+        loadFactor = loadFac;
+        threshold = (int)(iniCap * loadFac);
+        accessOrder = order;
+        maxSize = maxEntries;
+        for (int i = 0; i < cap; ++i) buckets[i] = NULL;
+        header.before = header.after = &header;
+        sz = 0;
+    }
+
+    protected:
+    /**
+     * Called after a new mapping is inserted, with the eldest entry of the
+     * map (the least recently inserted, or accessed in access-order mode).
+     * Returns true if that entry should be removed.
+     * The default evicts once the map holds more than maxEntries mappings.
+     */
+    virtual bool removeEldestEntry(const Entry<K, V>&) const {
+        return maxSize > 0 && sz > maxSize;
+    }
+
+    public:
+    class ConstIterator {
+        private:
+        const Link *nxt, *end;
+
+        public:
+        void init(const Link *_nxt, const Link *_end) {
+            nxt = _nxt; end = _end;
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return nxt != end;
+        }
+
+        /**
+         * Returns a const reference the next element in the iteration.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        const Entry<K, V>& next() {
+            if (nxt == end) throw ElementNotExist("\nNo Such Element\n");
+            const LinkedEntry *e = static_cast<const LinkedEntry*>(nxt);
+            nxt = nxt->after;
+            return *e;
+        }
+    };
+
+    class Iterator {
+        private:
+        Link *nxt;
+        LinkedEntry *last;
+        LinkedHashMap *map;
+
+        public:
+        void init(LinkedHashMap *_map) {
+            map = _map; nxt = map->header.after;
+            last = NULL;
+        }
+
+        /**
+         * Returns true if the iteration has more elements.
+         * O(1)
+         */
+        bool hasNext() {
+            return nxt != &map->header;
+        }
+
+        /**
+         * Returns a reference the next element in the iteration.
+         * O(1)
+         * @throw ElementNotExist
+         */
+        Entry<K, V>& next() {
+            if (nxt == &map->header) throw ElementNotExist("\nNo Such Element\n");
+            last = entryOf(nxt);
+            nxt = nxt->after;
+            return *last;
+        }
+
+        /**
+         * Removes from the underlying collection the last element returned by the iterator.
+         * O(1) for average
+         * @throw ElementNotExist
+         */
+        void remove() {
+            if (last == NULL) throw ElementNotExist("\nIllegal State\n");
+            map->removeEntry(last);
+            last = NULL;
+        }
+    };
+
+    /**
+     * Constructs an empty map in insertion order.
+     */
+    LinkedHashMap() {
+        init(DEFAULT_CAPCITY, DEFAULT_LOAD_FACTOR, INSERTION_ORDER, 0);
+    }
+
+    /**
+     * Constructs an empty map holding at most maxEntries mappings
+     * (0 for no bound), in insertion order or in access order. The table
+     * holds maxEntries + 1 mappings without growing, since put inserts
+     * before it evicts the eldest entry.
+     */
+    LinkedHashMap(int maxEntries, bool order) {
+        init(getMax((maxEntries + 1) * 4 / 3 + 1, DEFAULT_CAPCITY), DEFAULT_LOAD_FACTOR, order, maxEntries);
+    }
+
+    /**
+     * Copy constructor, keeping the order mode, the bound and the
+     * iteration order.
+     */
+    LinkedHashMap(const LinkedHashMap &x) {
+        init(getMax(x.size() * 2, DEFAULT_CAPCITY), DEFAULT_LOAD_FACTOR, x.accessOrder, x.maxSize);
+        addAll(*this, x);
+    }
+
+    /**
+     * Constructs a new map in insertion order with the same mappings as the
+     * specified map.
+     */
+    template <class E2>
+    explicit LinkedHashMap(const E2 &m) {
+        init(getMax(m.size() * 2, DEFAULT_CAPCITY), DEFAULT_LOAD_FACTOR, INSERTION_ORDER, 0);
+        addAll(*this, m);
+    }
+
+    /**
+     * Assignment operator. The order mode and the bound of this map are kept.
+     */
+    LinkedHashMap& operator = (const LinkedHashMap &x) {
+        if (this == &x) return *this;
+        clear();
+        addAll(*this, x);
+        return *this;
+    }
+
+    /**
+     * Destructor
+     */
+    virtual ~LinkedHashMap() {
+        getSpace();
+        delete [] buckets;
+    }
+
+    /**
+     * Returns an iterator over the entries from the eldest to the youngest.
+     * Iterating does not count as an access.
+     */
+    Iterator iterator() {
+        Iterator Itr;
+        Itr.init(this);
+        return Itr;
+    }
+
+    /**
+     * Returns an CONST iterator over the entries from the eldest to the youngest.
+     */
+    ConstIterator constIterator() const {
+        ConstIterator CItr;
+        CItr.init(header.after, &header);
+        return CItr;
+    }
+
+    /**
+     * Removes all of the mappings from this map.
+     * O(n)
+     */
+    void clear() {
+        getSpace();
+        for (int i = 0; i < cap; ++i) buckets[i] = NULL;
+        header.before = header.after = &header;
+        sz = 0;
+    }
+
+    /**
+     * Returns true if this map contains a mapping for the specified key.
+     * Does not count as an access.
+     * O(1) for average
+     */
+    bool containsKey(const K& key) const {
+        return getEntry(key) != NULL;
+    }
+
+    /**
+     * Returns true if this map maps one or more keys to the specified value.
+     * O(n)
+     */
+    bool containsValue(const V& value) const {
+        for (const Link *l = header.after; l != &header; l = l->after)
+            if (value == static_cast<const LinkedEntry*>(l)->value) return true;
+        return false;
+    }
+
+    /**
+     * Returns a reference to the value to which the specified key is mapped.
+     * In access-order mode the entry becomes the youngest.
+     * O(1) for average
+     * @throw ElementNotExist
+     */
+    V& get(const K& key) {
+        LinkedEntry *e = getEntry(key);
+        if (e == NULL) throw ElementNotExist("\nNo Such Key\n");
+        recordAccess(e);
+        return e->value;
+    }
+
+    /**
+     * Returns a const reference to the value to which the specified key is
+     * mapped. Does not count as an access.
+     * O(1) for average
+     * @throw ElementNotExist
+     */
+    const V& get(const K& key) const {
+        LinkedEntry *e = getEntry(key);
+        if (e == NULL) throw ElementNotExist("\nNo Such Key\n");
+        return e->value;
+    }
+
+    /**
+     * Returns the eldest entry: the least recently inserted one, or the
+     * least recently accessed one in access-order mode.
+     * O(1)
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& eldest() const {
+        if (sz == 0) throw ElementNotExist("\nNo Such Element\n");
+        return *static_cast<const LinkedEntry*>(header.after);
+    }
+
+    /**
+     * Returns true if this map contains no key-value mappings.
+     * O(1)
+     */
+    bool isEmpty() const {
+        return sz == 0;
+    }
+
+    void add(const Entry<K, V>& e) {
+        put(e.key, e.value);
+    }
+
+    /**
+     * Associates the specified value with the specified key in this map.
+     * A new key is appended to the order; in access-order mode an existing
+     * key becomes the youngest. Afterwards the eldest entry is evicted if
+     * removeEldestEntry() asks for it.
+     * Returns the previous value, if not exist, a value returned by the default-constructor.
+     * O(1) for average
+     */
+    V put(const K& key, const V& value) {
+        int idx = hash(key);
+        for (LinkedEntry *e = buckets[idx]; e != NULL; e = e->next)
+            if (key == e->key) {
+                V r = e->value;
+                e->value = value;
+                recordAccess(e);
+                return r;
+            }
+        if (++sz > threshold) {
+            rehash();
+            idx = hash(key);
+        }
+        LinkedEntry *e = new LinkedEntry(key, value, buckets[idx]);
+        buckets[idx] = e;
+        linkLast(e);
+        LinkedEntry *first = entryOf(header.after);
+        if (first != e && removeEldestEntry(*first)) removeEntry(first);
+        V r; return r;
+    }
+
+    /**
+     * Removes the mapping for the specified key from this map if present.
+     * Returns the previous value.
+     * O(1) for average
+     * @throw ElementNotExist
+     */
+    V remove(const K& key) {
+        LinkedEntry *e = getEntry(key);
+        if (e == NULL) throw ElementNotExist("\nNo Such Key\n");
+        V r = e->value;
+        removeEntry(e);
+        return r;
+    }
+
+    /**
+     * Returns the number of key-value mappings in this map.
+     * O(1)
+     */
+    int size() const {
+        return sz;
+    }
+};
+#endif
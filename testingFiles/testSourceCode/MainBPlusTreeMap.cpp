@@ -0,0 +1,51 @@
+#include "Utility.h"
+#include "TreeMap.h"
+#include "BPlusTreeMap.h"
+
+#include<cstdio>
+#include<cstdlib>
+#include<ctime>
+#include<sys/time.h>
+
+/**
+ * Puts N random keys, looks up N random keys and iterates once, on a
+ * BPlusTreeMap and on a TreeMap with the same keys, and prints the time
+ * each step takes.
+ */
+
+double now() {
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+template <class M> long long run(const char *name, int N, unsigned int seed) {
+    M tree;
+    srand(seed);
+    double start = now();
+    for (int i = 1; i <= N; ++i) tree.put(rand(), i);
+    double put = now();
+    long long sum = 0;
+    for (int i = 1; i <= N; ++i) sum += tree.containsKey(rand());
+    double get = now();
+    typename M::ConstIterator iter = tree.constIterator();
+    while (iter.hasNext()) sum += iter.next().value;
+    double end = now();
+    printf("%s: PUT %.2f GET %.2f ITERATE %.2f\n", name, put - start, get - put, end - get);
+    return sum;
+}
+
+int main(int argc, char **argv) {
+
+    int N = atoi(argv[1]);
+
+    unsigned int seed = time(NULL);
+    long long sum = run<BPlusTreeMap<int, int> >("BPlusTreeMap", N, seed);
+    if (run<TreeMap<int, int> >("TreeMap", N, seed) != sum) {
+        printf("BPlusTreeMap and TreeMap disagree\n");
+        return 1;
+    }
+
+    return sum == 0;
+
+}
@@ -0,0 +1,17 @@
+import java.util.*;
+
+public class MainBPlusTreeMap {
+    public static void main(String args[]) {
+        
+        int N = Integer.parseInt(args[0]);
+
+        Random random = new Random();
+        TreeMap<Integer, Integer> tree = new TreeMap<Integer, Integer>();
+        for (int i = 1; i <= N; ++i) tree.put(random.nextInt(), i);
+        long sum = 0;
+        for (int i = 1; i <= N; ++i) if (tree.containsKey(random.nextInt())) sum++;
+        for (Map.Entry<Integer, Integer> e : tree.entrySet()) sum += e.getValue();
+
+        if (sum == 0) System.exit(1);
+    }
+}
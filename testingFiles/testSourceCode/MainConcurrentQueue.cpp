@@ -0,0 +1,102 @@
+#include "Utility.h"
+#include "LinkedList.h"
+#include "ConcurrentLinkedQueue.h"
+#include "ConcurrentArrayQueue.h"
+
+#include<cstdio>
+#include<cstdlib>
+#include<pthread.h>
+#include<sched.h>
+#include<sys/time.h>
+
+/**
+ * Passes N ints from 4 producer threads to 4 consumer threads through
+ * a LinkedList guarded by a mutex, a ConcurrentLinkedQueue and a
+ * ConcurrentArrayQueue, and prints the time each one takes.
+ */
+
+const int THREADS = 4;
+
+class LockedList {
+    public:
+    LinkedList<int> lnk;
+    pthread_mutex_t mutex;
+    LockedList() { pthread_mutex_init(&mutex, NULL); }
+    ~LockedList() { pthread_mutex_destroy(&mutex); }
+    bool add(int x) {
+        pthread_mutex_lock(&mutex);
+        lnk.add(x);
+        pthread_mutex_unlock(&mutex);
+        return true;
+    }
+    bool poll(int &x) {
+        pthread_mutex_lock(&mutex);
+        bool res = !lnk.isEmpty();
+        if (res) x = lnk.removeFirst();
+        pthread_mutex_unlock(&mutex);
+        return res;
+    }
+};
+
+template <class Q> class Task {
+    public:
+    Q *queue;
+    int count;
+    long long sum;
+};
+
+template <class Q> void* produce(void *arg) {
+    Task<Q> *task = (Task<Q>*)arg;
+    for (int i = 1; i <= task->count; ++i)
+        while (!task->queue->add(i)) sched_yield();
+    return NULL;
+}
+
+template <class Q> void* consume(void *arg) {
+    Task<Q> *task = (Task<Q>*)arg;
+    int x;
+    for (int i = 0; i < task->count; ++i) {
+        while (!task->queue->poll(x)) sched_yield();
+        task->sum += x;
+    }
+    return NULL;
+}
+
+double now() {
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+template <class Q> void run(const char *name, Q &queue, int tot) {
+    Task<Q> tasks[2 * THREADS];
+    pthread_t threads[2 * THREADS];
+    double start = now();
+    for (int i = 0; i < 2 * THREADS; ++i) {
+        tasks[i].queue = &queue; tasks[i].count = tot; tasks[i].sum = 0;
+        pthread_create(&threads[i], NULL, i < THREADS ? produce<Q> : consume<Q>, &tasks[i]);
+    }
+    long long sum = 0;
+    for (int i = 0; i < 2 * THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+        sum += tasks[i].sum;
+    }
+    if (sum != (long long)THREADS * tot * (tot + 1) / 2) printf("%s: WRONG SUM\n", name);
+    printf("%s: TIME %.2f\n", name, now() - start);
+}
+
+int main(int argc, char **argv) {
+
+    int N = atoi(argv[1]);
+    int tot = N / THREADS;
+
+    LockedList locked;
+    run("LinkedList with mutex", locked, tot);
+    ConcurrentLinkedQueue<int> linked;
+    run("ConcurrentLinkedQueue", linked, tot);
+    ConcurrentArrayQueue<int> ring(1 << 16);
+    run("ConcurrentArrayQueue", ring, tot);
+
+    return 0;
+
+}
@@ -0,0 +1,29 @@
+
+import java.util.concurrent.*;
+
+public class MainConcurrentQueue {
+    static final int THREADS = 4;
+
+    public static void main(String args[]) throws InterruptedException {
+        
+        int N = Integer.parseInt(args[0]);
+        final int tot = N / THREADS;
+
+        final ConcurrentLinkedQueue<Integer> queue = new ConcurrentLinkedQueue<Integer>();
+        Thread[] threads = new Thread[2 * THREADS];
+        for (int t = 0; t < 2 * THREADS; ++t) {
+            final boolean producer = t < THREADS;
+            threads[t] = new Thread() {
+                public void run() {
+                    for (int i = 1; i <= tot; ++i) {
+                        if (producer) queue.add(i);
+                        else while (queue.poll() == null) Thread.yield();
+                    }
+                }
+            };
+            threads[t].start();
+        }
+        for (int t = 0; t < 2 * THREADS; ++t) threads[t].join();
+
+    }
+}
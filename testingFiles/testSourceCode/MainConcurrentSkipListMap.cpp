@@ -0,0 +1,123 @@
+#include "Utility.h"
+#include "TreeMap.h"
+#include "ConcurrentSkipListMap.h"
+
+#include<cstdio>
+#include<cstdlib>
+#include<pthread.h>
+#include<sys/time.h>
+
+/**
+ * Runs N operations on random keys less than N, split among 4 threads: half
+ * of them containsKey, a quarter put and a quarter remove, on a TreeMap
+ * guarded by a mutex and on a ConcurrentSkipListMap, and prints the time
+ * each one takes. Then runs the same mix on a ConcurrentSkipListMap with
+ * only 8 keys, so that puts and removes of the same key keep overlapping,
+ * and checks that its iteration agrees with its size.
+ */
+
+const int THREADS = 4;
+
+class LockedTreeMap {
+    public:
+    TreeMap<int, int> map;
+    pthread_mutex_t mutex;
+    LockedTreeMap() { pthread_mutex_init(&mutex, NULL); }
+    ~LockedTreeMap() { pthread_mutex_destroy(&mutex); }
+    bool containsKey(int key) {
+        pthread_mutex_lock(&mutex);
+        bool res = map.containsKey(key);
+        pthread_mutex_unlock(&mutex);
+        return res;
+    }
+    void put(int key, int value) {
+        pthread_mutex_lock(&mutex);
+        map.put(key, value);
+        pthread_mutex_unlock(&mutex);
+    }
+    void remove(int key) {
+        pthread_mutex_lock(&mutex);
+        if (map.containsKey(key)) map.remove(key);
+        pthread_mutex_unlock(&mutex);
+    }
+};
+
+class SkipListMap {
+    public:
+    ConcurrentSkipListMap<int, int> map;
+    bool containsKey(int key) {
+        return map.containsKey(key);
+    }
+    void put(int key, int value) {
+        map.put(key, value);
+    }
+    void remove(int key) {
+        try {
+            map.remove(key);
+        } catch (ElementNotExist &) {}
+    }
+};
+
+template <class M> class Task {
+    public:
+    M *map;
+    int count, range, found;
+    unsigned int seed;
+};
+
+template <class M> void* work(void *arg) {
+    Task<M> *task = (Task<M>*)arg;
+    for (int i = 0; i < task->count; ++i) {
+        task->seed = task->seed * 1103515245 + 12345;
+        int key = (task->seed >> 4) % task->range;
+        switch (task->seed >> 30) {
+            case 0: task->map->put(key, i); break;
+            case 1: task->map->remove(key); break;
+            default: if (task->map->containsKey(key)) task->found++;
+        }
+    }
+    return NULL;
+}
+
+double now() {
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+template <class M> void run(const char *name, M &map, int N, int range) {
+    Task<M> tasks[THREADS];
+    pthread_t threads[THREADS];
+    double start = now();
+    for (int i = 0; i < THREADS; ++i) {
+        tasks[i].map = &map; tasks[i].count = N / THREADS; tasks[i].range = range;
+        tasks[i].found = 0; tasks[i].seed = i + 1;
+        pthread_create(&threads[i], NULL, work<M>, &tasks[i]);
+    }
+    for (int i = 0; i < THREADS; ++i)
+        pthread_join(threads[i], NULL);
+    printf("%s: TIME %.2f\n", name, now() - start);
+}
+
+int main(int argc, char **argv) {
+
+    int N = atoi(argv[1]);
+
+    LockedTreeMap locked;
+    run("TreeMap with mutex", locked, N, N);
+    SkipListMap skipList;
+    run("ConcurrentSkipListMap", skipList, N, N);
+
+    SkipListMap small;
+    run("ConcurrentSkipListMap, 8 keys", small, N, 8);
+    int cnt = 0;
+    for (ConcurrentSkipListMap<int, int>::ConstIterator iter = small.map.constIterator(); iter.hasNext(); iter.next())
+        cnt++;
+    if (cnt != small.map.size()) {
+        printf("ConcurrentSkipListMap, 8 keys: %d mappings iterated, size %d\n", cnt, small.map.size());
+        return 1;
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,33 @@
+import java.util.concurrent.*;
+
+public class MainConcurrentSkipListMap {
+    static final int THREADS = 4;
+
+    public static void main(String args[]) throws InterruptedException {
+
+        final int N = Integer.parseInt(args[0]);
+
+        final ConcurrentSkipListMap<Integer, Integer> map = new ConcurrentSkipListMap<Integer, Integer>();
+        Thread[] threads = new Thread[THREADS];
+        for (int t = 0; t < THREADS; ++t) {
+            final int id = t;
+            threads[t] = new Thread() {
+                public void run() {
+                    int seed = id + 1, found = 0;
+                    for (int i = 0; i < N / THREADS; ++i) {
+                        seed = seed * 1103515245 + 12345;
+                        int key = (seed >>> 4) % N;
+                        switch (seed >>> 30) {
+                            case 0: map.put(key, i); break;
+                            case 1: map.remove(key); break;
+                            default: if (map.containsKey(key)) found++;
+                        }
+                    }
+                }
+            };
+            threads[t].start();
+        }
+        for (int t = 0; t < THREADS; ++t) threads[t].join();
+
+    }
+}
@@ -3,253 +3,743 @@
 #define __TREEMAP_H
 
 #include "Utility.h"
+#include<limits>
+#include<new>
+#include<stdint.h>
+
+/**
+ * The default augmentation of TreeMap nodes: nothing is stored.
+ *
+ * An augmentation is a class every node derives from, with a static
+ * ``update'' function recomputing the data of a node from its own entry and
+ * its children, whose data is already up to date. The data of the sentinel
+ * leaf is whatever the default constructor leaves. TreeMap calls update
+ * whenever the children of a node change, so the data of every node
+ * describes its whole subtree. The constant THREADED tells whether the
+ * class derives from Threaded.
+ */
+class NoAugment {
+    public:
+    static const bool AUGMENTED = false, THREADED = false;
+    typedef void AggregateValue;
+    template <class N> static void update(N*) {}
+};
+
+/**
+ * Augmentation storing the number of nodes of every subtree, which gives
+ * TreeMap the order-statistic queries rank, select and countRange.
+ */
+class OrderStatistic {
+    public:
+    static const bool AUGMENTED = true, THREADED = false;
+    typedef void AggregateValue;
+    int subtreeSize;
+    OrderStatistic(): subtreeSize(0) {}
+    template <class N> static void update(N* node) {
+        node->subtreeSize = node->left->subtreeSize + node->right->subtreeSize + 1;
+    }
+};
+
+/**
+ * Augmentation storing, for every subtree, the combination of its values in
+ * key order under the monoid M, which gives TreeMap the aggregate query.
+ *
+ * M is a class with static functions ``identity'', returning the neutral
+ * element of type T, and ``combine'', an associative operation on two T.
+ * The values of the map must convert to T. Base is another augmentation
+ * maintained alongside, such as OrderStatistic.
+ */
+template <class T, class M, class Base = NoAugment>
+class RangeAggregate: public Base {
+    public:
+    static const bool AUGMENTED = true;
+    typedef T AggregateValue;
+    typedef M Monoid;
+    T agg;
+    RangeAggregate(): agg(M::identity()) {}
+    template <class N> static void update(N* node) {
+        Base::update(node);
+        node->agg = M::combine(M::combine(node->left->agg, node->value), node->right->agg);
+    }
+};
+
+/**
+ * The links of a node on the in-order list of a threaded TreeMap.
+ */
+class ThreadLink {
+    public:
+    ThreadLink *before, *after;
+};
+
+/**
+ * Augmentation threading the nodes on a doubly linked list in key order,
+ * whose head is the sentinel leaf, at the cost of two pointers per node.
+ * The iterators then step in O(1) rather than amortized O(1), in both
+ * directions. Base is another augmentation maintained alongside.
+ */
+template <class Base = NoAugment>
+class Threaded: public Base, public ThreadLink {
+    public:
+    static const bool THREADED = true;
+    template <class N> static void update(N* node) {
+        Base::update(node);
+    }
+};
+
+/**
+ * Monoid for RangeAggregate: the sum of the values.
+ */
+template <class T> class SumMonoid {
+    public:
+    static T identity() { return T(); }
+    static T combine(const T& a, const T& b) { return a + b; }
+};
+
+/**
+ * Monoid for RangeAggregate: the least value.
+ */
+template <class T> class MinMonoid {
+    public:
+    static T identity() { return std::numeric_limits<T>::max(); }
+    static T combine(const T& a, const T& b) { return b < a ? b : a; }
+};
+
+/**
+ * Monoid for RangeAggregate: the greatest value.
+ */
+template <class T> class MaxMonoid {
+    public:
+    static T identity() { return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::min(); }
+    static T combine(const T& a, const T& b) { return a < b ? b : a; }
+};
 
 /**
  * A map is a sequence of (key, value) entries that provides fast retrieval
  * based on the key. At most one value is held for each key.
  *
  * TreeMap is the balanced-tree implementation of map. The iterators must
- * iterate through the map in the natural order (operator<) of the key.
+ * iterate through the map in the order of the key given by the comparator.
+ *
+ * Template argument C is the comparator class, as for LinkedList::sort, with
+ * a static function ``compare'' returning a negative number, zero or a
+ * positive number. It defaults to Comparator<K>, the natural order
+ * (operator<). Each node on a search path costs a single call to compare,
+ * and the lookups containsKey, get and remove accept any key type the
+ * comparator can compare with K, such as a const char* for std::string.
+ *
+ * Template argument A is the augmentation of the nodes, NoAugment by
+ * default. For example
+ * @code
+ *      TreeMap<int, int, Comparator<int>, OrderStatistic> map;
+ * @endcode
+ * is a map supporting rank, select and countRange in O(logn), and
+ * @code
+ *      TreeMap<int, long long, Comparator<int>, RangeAggregate<long long, SumMonoid<long long> > > map;
+ * @endcode
+ * answers the sum of the values over a range of keys in O(logn), and
+ * @code
+ *      TreeMap<int, int, Comparator<int>, Threaded<> > map;
+ * @endcode
+ * iterates in O(1) per step. With an
+ * augmentation depending on the values, they must be changed through put
+ * only, not through the references returned by get or the iterators.
+ *
+ * The nodes are allocated from slabs owned by the map, and the color of a
+ * node is kept in the lowest bit of its parent pointer. The memory of
+ * removed nodes is reused by later insertions and given back by clear and
+ * the destructor.
  */
-template<class K, class V> class TreeMap {
+template<class K, class V, class C = Comparator<K>, class A = NoAugment> class TreeMap {
     private:
     static const int RED = -1, BLACK = 1; 
+    template <bool B> class Flag {};
+    typedef Flag<A::THREADED> Threading;
     template <class K2, class V2>
-    class Node: public Entry<K2, V2> {
+    class Node: public Entry<K2, V2>, public A {
         public:
-        int color;
-        Node<K2, V2> *left, *right, *parent;
+        Node<K2, V2> *left, *right;
+        /**
+         * The parent pointer, whose lowest bit, always clear in a node
+         * address, is set for a red node and clear for a black one.
+         */
+        uintptr_t parentColor;
         Node(): Entry<K2, V2>(K(), V()) {
-            color = BLACK;
-            left = right = parent = this;
+            left = right = this;
+            parentColor = (uintptr_t)this;
         }
         Node(K2 _key, V2 _value, int _color, Node<K2, V2>* _left, Node<K2, V2>* _right, Node<K2, V2>* _parent): Entry<K2, V2>(_key, _value) {
-           color = _color; 
-           left = _left; right = _right; parent = _parent;
+            left = _left; right = _right;
+            parentColor = (uintptr_t)_parent | (_color == RED);
+            A::update(this);
         }
+        Node<K2, V2>* parent() const {
+            return (Node<K2, V2>*)(parentColor & ~(uintptr_t)1);
+        }
+        int color() const {
+            return (parentColor & 1) ? RED : BLACK;
+        }
+        void setParent(Node<K2, V2>* _parent) {
+            parentColor = (uintptr_t)_parent | (parentColor & 1);
+        }
+        void setColor(int _color) {
+            parentColor = (parentColor & ~(uintptr_t)1) | (_color == RED);
+        }
+    };
+    /**
+     * Header of a slab of nodes, aligned for any node type.
+     */
+    union Slab {
+        Slab *next;
+        long double ld;
+        long long ll;
+        void *p;
     };
+    static const int FIRST_SLAB_NODES = 16, MAX_SLAB_NODES = 4096;
     Node<K, V> *nil, *root;
+    /**
+     * The nodes of the least and of the greatest key, or nil. put checks
+     * rightmost first so that keys arriving in increasing order are
+     * appended without a descent.
+     */
+    Node<K, V> *leftmost, *rightmost;
     int sz;
+    Slab *slabs;
+    char *slabCur, *slabEnd;
+    int slabNodes;
+    void *freeNodes;
 
     void fabricateTree() {
         nil = new Node<K, V>;
         root = nil;
         sz = 0;
+        slabs = NULL;
+        slabCur = slabEnd = NULL;
+        slabNodes = FIRST_SLAB_NODES / 2;
+        freeNodes = NULL;
+        rethread();
+    }
+
+    /**
+     * Returns raw memory for one node: a node freed earlier, or the next
+     * slot of the current slab. A new slab is twice as large as the last,
+     * up to MAX_SLAB_NODES nodes, so the nodes of a map sit close together
+     * and cost no allocator header each.
+     */
+    void* allocNode() {
+        if (freeNodes != NULL) {
+            void *mem = freeNodes;
+            freeNodes = *(void**)mem;
+            return mem;
+        }
+        if (slabCur == slabEnd) {
+            if (slabNodes < MAX_SLAB_NODES) slabNodes *= 2;
+            Slab *slab = (Slab*)::operator new(sizeof(Slab) + slabNodes * sizeof(Node<K, V>));
+            slab->next = slabs;
+            slabs = slab;
+            slabCur = (char*)(slab + 1);
+            slabEnd = slabCur + slabNodes * sizeof(Node<K, V>);
+        }
+        void *mem = slabCur;
+        slabCur += sizeof(Node<K, V>);
+        return mem;
+    }
+
+    Node<K, V>* newNode(const K& key, const V& value, int color, Node<K, V>* parent) {
+        return new (allocNode()) Node<K, V>(key, value, color, nil, nil, parent);
+    }
+
+    /**
+     * Destroys node and puts its memory on the free list.
+     */
+    void freeNode(Node<K, V>* node) {
+        node->~Node();
+        *(void**)node = freeNodes;
+        freeNodes = node;
+    }
+
+    /**
+     * Gives the memory of all the slabs back. Every node must have been
+     * destroyed.
+     */
+    void releaseSlabs() {
+        while (slabs != NULL) {
+            Slab *next = slabs->next;
+            ::operator delete(slabs);
+            slabs = next;
+        }
+        slabCur = slabEnd = NULL;
+        slabNodes = FIRST_SLAB_NODES / 2;
+        freeNodes = NULL;
     }
 
     Node<K, V>* firstNode() const {
-        Node<K, V> *node = root;
-        while (node->left != nil) 
-            node = node->left;
-        return node;
+        return leftmost;
     }
 
     Node<K, V>* lastNode() const {
-        Node<K, V> *node = root;
-        while (node->right != nil)
-            node = node->right;
+        return rightmost;
+    }
+
+    /**
+     * Recomputes leftmost and rightmost, and the in-order list of a
+     * threaded map, for a tree not built by attach.
+     */
+    void rethread() {
+        leftmost = rightmost = root;
+        if (root != nil) {
+            while (leftmost->left != nil)
+                leftmost = leftmost->left;
+            while (rightmost->right != nil)
+                rightmost = rightmost->right;
+        }
+        rethread(Threading());
+    }
+
+    void rethread(Flag<false>) {}
+
+    void rethread(Flag<true>) {
+        nil->before = nil->after = nil;
+        Node<K, V> *last = nil;
+        for (Node<K, V> *node = leftmost; node != nil; node = successor(node, Flag<false>())) {
+            linkBetween(node, last, nil);
+            last = node;
+        }
+    }
+
+    void linkBetween(Node<K, V>* node, Node<K, V>* before, Node<K, V>* after) {
+        node->before = before;
+        node->after = after;
+        before->after = node;
+        after->before = node;
+    }
+
+    /**
+     * Puts node, just linked in the tree, on the in-order list.
+     */
+    void thread(Node<K, V>*, Flag<false>) {}
+
+    void thread(Node<K, V>* node, Flag<true>) {
+        Node<K, V> *parent = node->parent();
+        if (parent == nil) linkBetween(node, nil, nil);
+        else if (node == parent->right) linkBetween(node, parent, successor(parent));
+        else linkBetween(node, predecessor(parent), parent);
+    }
+
+    void unthread(Node<K, V>*, Flag<false>) {}
+
+    void unthread(Node<K, V>* node, Flag<true>) {
+        node->before->after = node->after;
+        node->after->before = node->before;
+    }
+
+    /**
+     * Destroys the subtree rooted at node in post-order, without
+     * rebalancing. The memory stays in the slabs.
+     */
+    void destroy(Node<K, V>* node) {
+        while (node != nil) {
+            destroy(node->right);
+            Node<K, V> *left = node->left;
+            node->~Node();
+            node = left;
+        }
+    }
+
+    /**
+     * Copies the subtree rooted at src, whose leaves are srcNil, node by
+     * node with the same shape and colors.
+     */
+    Node<K, V>* clone(const Node<K, V>* src, const Node<K, V>* srcNil, Node<K, V>* parent) {
+        if (src == srcNil) return nil;
+        Node<K, V> *node = newNode(src->key, src->value, src->color(), parent);
+        node->left = clone(src->left, srcNil, node);
+        node->right = clone(src->right, srcNil, node);
+        A::update(node);
+        return node;
+    }
+
+    Node<K, V>* makeNode(const Entry<K, V>& e, const V*) {
+        return newNode(e.key, e.value, BLACK, nil);
+    }
+
+    Node<K, V>* makeNode(const K& key, const V* value) {
+        return newNode(key, *value, BLACK, nil);
+    }
+
+    /**
+     * Builds a perfectly balanced tree of the elements lo..hi taken in order
+     * from iter. All levels are black except the deepest one when it is
+     * incomplete, whose nodes are red.
+     */
+    template <class I>
+    Node<K, V>* buildFromSorted(int depth, int lo, int hi, int redLevel, I& iter, const V* value) {
+        if (lo > hi) return nil;
+        int mid = (lo + hi) >> 1;
+        Node<K, V> *left = buildFromSorted(depth + 1, lo, mid - 1, redLevel, iter, value);
+        Node<K, V> *node = makeNode(iter.next(), value);
+        if (depth == redLevel) node->setColor(RED);
+        node->left = left;
+        if (left != nil) left->setParent(node);
+        node->right = buildFromSorted(depth + 1, mid + 1, hi, redLevel, iter, value);
+        if (node->right != nil) node->right->setParent(node);
+        A::update(node);
         return node;
     }
 
+    template <class I>
+    void buildFromSorted(I& iter, int n, const V* value) {
+        clear();
+        int redLevel = 0;
+        for (int m = n - 1; m >= 0; m = m / 2 - 1) redLevel++;
+        root = buildFromSorted(0, 0, n - 1, redLevel, iter, value);
+        rethread();
+        sz = n;
+    }
+
+    /**
+     * Recomputes the augmented data of node and of all its ancestors.
+     */
+    void refreshToRoot(Node<K, V>* node) {
+        if (!A::AUGMENTED) return;
+        for (; node != nil; node = node->parent())
+            A::update(node);
+    }
+
+    /**
+     * Puts node in the place of old in the eyes of old's parent.
+     */
+    void replaceChild(Node<K, V>* old, Node<K, V>* node) {
+        Node<K, V> *parent = old->parent();
+        node->setParent(parent);
+        if (parent == nil) root = node;
+        else if (old == parent->left) parent->left = node;
+        else parent->right = node;
+    }
+
+    /**
+     * Unlinks node from the tree and frees it. A node with two children is
+     * replaced by its predecessor, which is relinked in its place rather
+     * than copied, so no other node moves or changes its key.
+     */
     void removeNode(Node<K, V>* node) {
-        Node<K, V> *splice, *child;
+        Node<K, V> *child, *parent;
+        int color;
         sz--;
-        if (node->left == nil) {
-            splice = node;
-            child = node->right;
-        }
-        else if (node->right == nil) {
-            splice = node;
-            child = node->left;
+        if (node == leftmost) leftmost = successor(node);
+        if (node == rightmost) rightmost = predecessor(node);
+        unthread(node, Threading());
+        if (node->left == nil || node->right == nil) {
+            child = node->left == nil ? node->right : node->left;
+            parent = node->parent();
+            color = node->color();
+            if (child != nil) child->setParent(parent);
+            if (parent == nil) root = child;
+            else if (node == parent->left) parent->left = child;
+            else parent->right = child;
         }
         else {
-            splice = node->left;
-            while (splice->right != nil) 
+            Node<K, V> *splice = node->left;
+            while (splice->right != nil)
                 splice = splice->right;
             child = splice->left;
-            Node<K, V> *newNode = new Node<K, V>(splice->key, splice->value, node->color, node->left, node->right, node->parent);
-            if (newNode->left != nil) newNode->left->parent = newNode;
-            if (newNode->right != nil) newNode->right->parent = newNode;
-            if (newNode->parent != nil) {
-                if (newNode->parent->left == node) newNode->parent->left = newNode;
-                else newNode->parent->right = newNode;
+            color = splice->color();
+            if (splice->parent() == node) parent = splice;
+            else {
+                parent = splice->parent();
+                parent->right = child;
+                if (child != nil) child->setParent(parent);
+                splice->left = node->left;
+                splice->left->setParent(splice);
             }
-            if (root == node) root = newNode;
-            delete node; node = newNode;
+            splice->right = node->right;
+            splice->right->setParent(splice);
+            splice->setColor(node->color());
+            replaceChild(node, splice);
         }
-
-        Node<K, V> *parent = splice->parent;
-        if (child != nil) child->parent = parent;
-        if (parent == nil) {
-            root = child;
-            delete splice;
-            return;
-        }
-        if (splice == parent->left) 
-            parent->left = child;
-        else parent->right = child;
-        if (splice->color == BLACK)
+        refreshToRoot(parent);
+        if (color == BLACK && parent != nil)
             deleteFixup(child, parent);
-        delete splice;
+        else if (child != nil) child->setColor(BLACK);
+        freeNode(node);
     }
 
-    Node<K, V>* getNode(K key) const {
+    template <class K2>
+    Node<K, V>* getNode(const K2& key) const {
         Node<K, V> *current = root;
         while (current != nil) {
-            if (key > current->key) current = current->right;
-            else if (key < current->key) current = current->left;
+            int c = C::compare(key, current->key);
+            if (c > 0) current = current->right;
+            else if (c < 0) current = current->left;
             else return current;
         }
         return current;
     }
 
+    /**
+     * Returns the node with the least key not less than key, or nil.
+     */
+    Node<K, V>* ceilingNode(const K& key) const {
+        Node<K, V> *current = root, *res = nil;
+        while (current != nil) {
+            if (C::compare(current->key, key) < 0) current = current->right;
+            else {
+                res = current;
+                current = current->left;
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Returns the node with the least key greater than key, or nil.
+     */
+    Node<K, V>* higherNode(const K& key) const {
+        Node<K, V> *current = root, *res = nil;
+        while (current != nil) {
+            if (C::compare(key, current->key) < 0) {
+                res = current;
+                current = current->left;
+            }
+            else current = current->right;
+        }
+        return res;
+    }
+
+    /**
+     * Returns the node with the greatest key not greater than key, or nil.
+     */
+    Node<K, V>* floorNode(const K& key) const {
+        Node<K, V> *current = root, *res = nil;
+        while (current != nil) {
+            if (C::compare(key, current->key) < 0) current = current->left;
+            else {
+                res = current;
+                current = current->right;
+            }
+        }
+        return res;
+    }
+
+    /**
+     * Returns the node with the greatest key less than key, or nil.
+     */
+    Node<K, V>* lowerNode(const K& key) const {
+        Node<K, V> *current = root, *res = nil;
+        while (current != nil) {
+            if (C::compare(current->key, key) < 0) {
+                res = current;
+                current = current->right;
+            }
+            else current = current->left;
+        }
+        return res;
+    }
+
+    const Entry<K, V>& entryOf(Node<K, V>* node) const {
+        if (node == nil) throw ElementNotExist("\nNo Such Element\n");
+        return *node;
+    }
+
     Node<K, V>* successor(Node<K, V>* node) const {
+        return successor(node, Threading());
+    }
+
+    Node<K, V>* successor(Node<K, V>* node, Flag<true>) const {
+        return static_cast<Node<K, V>*>(node->after);
+    }
+
+    Node<K, V>* successor(Node<K, V>* node, Flag<false>) const {
         if (node->right != nil) {
             node = node->right;
             while (node->left != nil)
                 node = node->left;
             return node;
         }
-        Node<K, V>* parent = node->parent;
+        Node<K, V>* parent = node->parent();
         while (node == parent->right) {
             node = parent;
-            parent = parent->parent;
+            parent = parent->parent();
+        }
+        return parent;
+    }
+
+    Node<K, V>* predecessor(Node<K, V>* node) const {
+        return predecessor(node, Threading());
+    }
+
+    Node<K, V>* predecessor(Node<K, V>* node, Flag<true>) const {
+        return static_cast<Node<K, V>*>(node->before);
+    }
+
+    Node<K, V>* predecessor(Node<K, V>* node, Flag<false>) const {
+        if (node->left != nil) {
+            node = node->left;
+            while (node->right != nil)
+                node = node->right;
+            return node;
+        }
+        Node<K, V>* parent = node->parent();
+        while (node == parent->left) {
+            node = parent;
+            parent = parent->parent();
         }
         return parent;
     }
 
+    /**
+     * Links a new node for key as the right child of parent if c > 0, as
+     * its left child otherwise, or as the root if parent is nil. The place
+     * must be free and in key order.
+     */
+    void attach(Node<K, V>* parent, int c, const K& key, const V& value) {
+        Node<K, V> *node = newNode(key, value, RED, parent);
+        sz++;
+        if (parent == nil) root = node;
+        else if (c > 0) parent->right = node;
+        else parent->left = node;
+        if (parent == leftmost && (parent == nil || c <= 0)) leftmost = node;
+        if (parent == rightmost && (parent == nil || c > 0)) rightmost = node;
+        thread(node, Threading());
+        refreshToRoot(parent);
+        insertFixup(node);
+    }
+
     void rotateLeft(Node<K, V>* node) {
         Node<K, V> * child = node->right;
         node->right = child->left;
         if (child->left != nil)
-            child->left->parent = node;
-        child->parent = node->parent;
-        if (node->parent != nil) {
-            if (node == node->parent->left)
-                node->parent->left = child;
-            else node->parent->right = child;
+            child->left->setParent(node);
+        child->setParent(node->parent());
+        if (node->parent() != nil) {
+            if (node == node->parent()->left)
+                node->parent()->left = child;
+            else node->parent()->right = child;
         }
         else root = child;
         child->left = node;
-        node->parent = child;
+        node->setParent(child);
+        A::update(node);
+        A::update(child);
     }
 
     void rotateRight(Node<K, V>* node) {
         Node<K, V> *child = node->left;
         node->left = child->right;
         if (child->right != nil)
-            child->right->parent = node;
-        child->parent = node->parent;
-        if (node->parent != nil) {
-            if (node == node->parent->right)
-                node->parent->right = child;
-            else node->parent->left = child;
+            child->right->setParent(node);
+        child->setParent(node->parent());
+        if (node->parent() != nil) {
+            if (node == node->parent()->right)
+                node->parent()->right = child;
+            else node->parent()->left = child;
         }
         else root = child;
         child->right = node;
-        node->parent = child;
+        node->setParent(child);
+        A::update(node);
+        A::update(child);
     }
 
     void insertFixup(Node<K, V>* node) {
-        while (node->parent->color == RED && node->parent->parent != nil) {
-            if (node->parent == node->parent->parent->left) {
-                Node<K, V> *uncle = node->parent->parent->right;
-                if (uncle->color == RED) {
-                    node->parent->color = BLACK;
-                    uncle->color = BLACK;
-                    uncle->parent->color = RED;
-                    node = uncle->parent;
+        while (node->parent()->color() == RED && node->parent()->parent() != nil) {
+            if (node->parent() == node->parent()->parent()->left) {
+                Node<K, V> *uncle = node->parent()->parent()->right;
+                if (uncle->color() == RED) {
+                    node->parent()->setColor(BLACK);
+                    uncle->setColor(BLACK);
+                    uncle->parent()->setColor(RED);
+                    node = uncle->parent();
                 }
                 else {
-                    if (node == node->parent->right) {
-                        node = node->parent;
+                    if (node == node->parent()->right) {
+                        node = node->parent();
                         rotateLeft(node);
                     }
-                    node->parent->color = BLACK ;
-                    node->parent->parent->color = RED;
-                    rotateRight(node->parent->parent);
+                    node->parent()->setColor(BLACK);
+                    node->parent()->parent()->setColor(RED);
+                    rotateRight(node->parent()->parent());
                 }
             }
             else {
-                Node<K, V> *uncle = node->parent->parent->left;
-                if (uncle->color == RED) {
-                    node->parent->color = BLACK;
-                    uncle->color = BLACK;
-                    uncle->parent->color = RED;
-                    node = uncle->parent;
+                Node<K, V> *uncle = node->parent()->parent()->left;
+                if (uncle->color() == RED) {
+                    node->parent()->setColor(BLACK);
+                    uncle->setColor(BLACK);
+                    uncle->parent()->setColor(RED);
+                    node = uncle->parent();
                 }
                 else {
-                    if (node == node->parent->left) {
-                        node = node->parent;
+                    if (node == node->parent()->left) {
+                        node = node->parent();
                         rotateRight(node);
                     }
-                    node->parent->color = BLACK;
-                    node->parent->parent->color = RED;
-                    rotateLeft(node->parent->parent);
+                    node->parent()->setColor(BLACK);
+                    node->parent()->parent()->setColor(RED);
+                    rotateLeft(node->parent()->parent());
                 }
             }
         }
-        root->color = BLACK;
+        root->setColor(BLACK);
     }
 
     void deleteFixup(Node<K, V>* node, Node<K, V> *parent) {
-        while (node != root && node->color == BLACK) {
+        while (node != root && node->color() == BLACK) {
             if (node == parent->left) {
                 Node<K, V> *sibling = parent->right;
-                if (sibling->color == RED) {
-                    sibling->color = BLACK;
-                    parent->color = RED;
+                if (sibling->color() == RED) {
+                    sibling->setColor(BLACK);
+                    parent->setColor(RED);
                     rotateLeft(parent);
                     sibling = parent->right;
                 }
-                if (sibling->left->color == BLACK && sibling->right->color == BLACK) {
-                    sibling->color = RED;
+                if (sibling->left->color() == BLACK && sibling->right->color() == BLACK) {
+                    sibling->setColor(RED);
                     node = parent;
-                    parent = parent->parent;
+                    parent = parent->parent();
                 }
                 else {
-                    if (sibling->right->color == BLACK) {
-                        sibling->left->color = BLACK;
-                        sibling->color = RED;
+                    if (sibling->right->color() == BLACK) {
+                        sibling->left->setColor(BLACK);
+                        sibling->setColor(RED);
                         rotateRight(sibling);
                         sibling = parent->right;
                     }   
-                    sibling->color = parent->color;
-                    parent->color = BLACK;
-                    sibling->right->color = BLACK;
+                    sibling->setColor(parent->color());
+                    parent->setColor(BLACK);
+                    sibling->right->setColor(BLACK);
                     rotateLeft(parent);
                     node = root;
                 }
             }
             else {
                 Node<K, V>* sibling = parent->left;
-                if (sibling->color == RED) {
-                    sibling->color = BLACK;
-                    parent->color = RED;
+                if (sibling->color() == RED) {
+                    sibling->setColor(BLACK);
+                    parent->setColor(RED);
                     rotateRight(parent);
                     sibling = parent->left;
                 }
-                if (sibling->right->color == BLACK && sibling->left->color == BLACK) {
-                    sibling->color = RED;
+                if (sibling->right->color() == BLACK && sibling->left->color() == BLACK) {
+                    sibling->setColor(RED);
                     node = parent;
-                    parent = parent->parent;
+                    parent = parent->parent();
                 }
                 else {
-                    if (sibling->left->color == BLACK) {
-                        sibling->right->color = BLACK;
-                        sibling->color = RED;
+                    if (sibling->left->color() == BLACK) {
+                        sibling->right->setColor(BLACK);
+                        sibling->setColor(RED);
                         rotateLeft(sibling);
                         sibling = parent->left;
                     }
-                    sibling->color = parent->color;
-                    parent->color = BLACK;
-                    sibling->left->color = BLACK;
+                    sibling->setColor(parent->color());
+                    parent->setColor(BLACK);
+                    sibling->left->setColor(BLACK);
                     rotateRight(parent);
                     node = root;
                 }
             }
         }
-        node->color = BLACK;
+        if (node != nil) node->setColor(BLACK);
     }
 
     public:
@@ -257,57 +747,78 @@ template<class K, class V> class TreeMap {
         private:
             Node<K, V> *last, *nxt;
             const TreeMap *treeM;
+            bool descending, hasHi;
+            /**
+             * The exclusive upper bound of a SubMap iterator, if hasHi.
+             */
+            K hi;
         public:
-        void init(Node<K, V> *_nxt, const TreeMap *_treeM) {
+        void init(Node<K, V> *_nxt, const TreeMap *_treeM, bool _descending = false) {
             nxt = _nxt; last = NULL; treeM = _treeM;
+            descending = _descending; hasHi = false;
+        }
+        void init(Node<K, V> *_nxt, const TreeMap *_treeM, const K& _hi) {
+            init(_nxt, _treeM);
+            hasHi = true; hi = _hi;
         }
         /**
          * Returns true if the iteration has more elements.
          * Amortized O(1).
          */
         bool hasNext() {
-            return nxt != treeM->nil;
+            return nxt != treeM->nil && (!hasHi || C::compare(nxt->key, hi) < 0);
         }
 
         /**
          * Returns a reference to the next element in the iteration.
-         * Amortized O(1).
+         * Amortized O(1), O(1) for a Threaded map.
          * @throw ElementNotExist
          */
         Entry<K, V>& next() {
-            if (nxt == treeM->nil) throw ElementNotExist("\nNo Such Element\n");
+            if (!hasNext()) throw ElementNotExist("\nNo Such Element\n");
             last = nxt;
-            nxt = treeM->successor(last);
+            nxt = descending ? treeM->predecessor(last) : treeM->successor(last);
             return *last;
         }
 
     };
 
     class Iterator {
+        friend class TreeMap;
         private:
             Node<K, V> *last, *nxt;
             TreeMap *treeM;
+            bool descending, hasHi;
+            /**
+             * The exclusive upper bound of a SubMap iterator, if hasHi.
+             */
+            K hi;
         public:
-        void init(Node<K, V> *_nxt, TreeMap *_treeM) {
+        void init(Node<K, V> *_nxt, TreeMap *_treeM, bool _descending = false) {
             nxt = _nxt; last = NULL; treeM = _treeM;
+            descending = _descending; hasHi = false;
+        }
+        void init(Node<K, V> *_nxt, TreeMap *_treeM, const K& _hi) {
+            init(_nxt, _treeM);
+            hasHi = true; hi = _hi;
         }
         /**
          * Returns true if the iteration has more elements.
          * Amortized O(1).
          */
         bool hasNext() {
-            return nxt != treeM->nil;
+            return nxt != treeM->nil && (!hasHi || C::compare(nxt->key, hi) < 0);
         }
 
         /**
          * Returns a reference to the next element in the iteration.
-         * Amortized O(1).
+         * Amortized O(1), O(1) for a Threaded map.
          * @throw ElementNotExist
          */
         Entry<K, V>& next() {
-            if (nxt == treeM->nil) throw ElementNotExist("\nNo Such Element\n");
+            if (!hasNext()) throw ElementNotExist("\nNo Such Element\n");
             last = nxt;
-            nxt = treeM->successor(last);
+            nxt = descending ? treeM->predecessor(last) : treeM->successor(last);
             return *last;
         }
 
@@ -324,6 +835,110 @@ template<class K, class V> class TreeMap {
         }
     };
 
+    /**
+     * A view of the mappings of a TreeMap whose keys lie in a range, from
+     * an inclusive lower bound to an exclusive upper bound, either of which
+     * may be absent. Nothing is copied: the iterators start at the lower
+     * bound in O(logn) and compare every key with the upper bound, so the
+     * view reflects later changes of the map, even during an iteration.
+     * A range whose lower bound is above its upper bound is empty.
+     */
+    class SubMap {
+        public:
+        typedef typename TreeMap<K, V, C, A>::ConstIterator ConstIterator;
+        typedef typename TreeMap<K, V, C, A>::Iterator Iterator;
+
+        private:
+        TreeMap *treeM;
+        K lo, hi;
+        bool hasLo, hasHi;
+
+        Node<K, V>* startNode() const {
+            return hasLo ? treeM->ceilingNode(lo) : treeM->firstNode();
+        }
+
+        /**
+         * Returns true if node is a node of the map below the upper bound.
+         */
+        bool belowHi(Node<K, V> *node) const {
+            return node != treeM->nil && (!hasHi || C::compare(node->key, hi) < 0);
+        }
+
+        template <class I>
+        void initIterator(I& itr) const {
+            if (hasHi) itr.init(startNode(), treeM, hi);
+            else itr.init(startNode(), treeM);
+        }
+
+        template <class K2>
+        bool inRange(const K2& key) const {
+            return (!hasLo || C::compare(key, lo) >= 0) && (!hasHi || C::compare(key, hi) < 0);
+        }
+
+        public:
+        SubMap(TreeMap *_treeM, const K& _lo, bool _hasLo, const K& _hi, bool _hasHi):
+            treeM(_treeM), lo(_lo), hi(_hi), hasLo(_hasLo), hasHi(_hasHi) {}
+
+        /**
+         * Returns an iterator over the mappings in this view.
+         * O(logn).
+         */
+        Iterator iterator() {
+            Iterator Itr;
+            initIterator(Itr);
+            return Itr;
+        }
+
+        /**
+         * Returns an const iterator over the mappings in this view.
+         * O(logn).
+         */
+        ConstIterator constIterator() const {
+            ConstIterator CItr;
+            initIterator(CItr);
+            return CItr;
+        }
+
+        /**
+         * Returns true if the key lies in the range and is in the map.
+         * O(logn).
+         */
+        template <class K2>
+        bool containsKey(const K2& key) const {
+            return inRange(key) && treeM->containsKey(key);
+        }
+
+        /**
+         * Returns a reference to the value which the specified key is mapped
+         * O(logn).
+         * @throw ElementNotExist
+         */
+        template <class K2>
+        V& get(const K2& key) {
+            if (!inRange(key)) throw ElementNotExist("\nNo Such Element\n");
+            return treeM->get(key);
+        }
+
+        /**
+         * Returns true if no key of the map lies in the range.
+         * O(logn).
+         */
+        bool isEmpty() const {
+            return !belowHi(startNode());
+        }
+
+        /**
+         * Returns the number of mappings in this view.
+         * O(logn + k), k being the result.
+         */
+        int size() const {
+            int cnt = 0;
+            for (Node<K, V> *node = startNode(); belowHi(node); node = treeM->successor(node))
+                cnt++;
+            return cnt;
+        }
+    };
+
     /**
      * Constructs an empty map
      */
@@ -332,27 +947,34 @@ template<class K, class V> class TreeMap {
     }
 
     /**
-     * Copy constructor
+     * Copy constructor, copying the tree node by node.
+     * O(n).
      */
     TreeMap(const TreeMap &c) {
         fabricateTree();
-        addAll(*this, c);
+        root = clone(c.root, c.nil, nil);
+        rethread();
+        sz = c.sz;
     }
 
     /**
      * Destructor
      */
     ~TreeMap() { 
-        delete nil;
         clear();
+        delete nil;
     }
 
     /**
-     * Assignment operator
+     * Assignment operator, copying the tree node by node.
+     * O(n).
      */
     TreeMap& operator=(const TreeMap &c) {
+        if (this == &c) return *this;
         clear();
-        addAll(*this, c);
+        root = clone(c.root, c.nil, nil);
+        rethread();
+        sz = c.sz;
         return *this;
     }
 
@@ -360,9 +982,9 @@ template<class K, class V> class TreeMap {
      * Constructs a new tree map containing the same mappings as the
      * given map
      */
-    template <class C> TreeMap(const C& c) {
+    template <class M> TreeMap(const M& m) {
         fabricateTree();
-        addAll(*this, c);
+        addAll(*this, m);
     }
 
     /**
@@ -385,21 +1007,68 @@ template<class K, class V> class TreeMap {
         return CItr;
     }
 
+    /**
+     * Returns an iterator over the elements in this map, from the greatest
+     * key to the least.
+     * O(1).
+     */
+    Iterator descendingIterator() {
+        Iterator Itr;
+        Itr.init(lastNode(), this, true);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator over the elements in this map, from the
+     * greatest key to the least.
+     * O(1).
+     */
+    ConstIterator descendingIterator() const {
+        ConstIterator CItr;
+        CItr.init(lastNode(), this, true);
+        return CItr;
+    }
+
     /**
      * Removes all of the mappings from this map.
      * O(n).
      */
     void clear() {
-        while (sz) {
-            removeNode(root);
-        }
+        destroy(root);
+        releaseSlabs();
+        root = nil;
+        rethread();
+        sz = 0;
+    }
+
+    /**
+     * Replaces the contents of this map with the first n entries returned
+     * by iter, which must come in strictly increasing order of their keys,
+     * as from the iterator of another TreeMap. The tree is built balanced
+     * directly, without comparisons or rebalancing.
+     * O(n).
+     */
+    template <class I>
+    void buildFromSorted(I iter, int n) {
+        buildFromSorted(iter, n, (const V*)NULL);
+    }
+
+    /**
+     * Like buildFromSorted, but iter returns keys in strictly increasing
+     * order, each of which is mapped to value.
+     * O(n).
+     */
+    template <class I>
+    void buildFromSortedKeys(I iter, int n, const V& value) {
+        buildFromSorted(iter, n, &value);
     }
 
     /**
      * Returns true if this map contains a mapping for the specified key.
      * O(logn).
      */
-    bool containsKey(const K& key) const {
+    template <class K2>
+    bool containsKey(const K2& key) const {
         return getNode(key) != nil;
     }
 
@@ -420,7 +1089,7 @@ template<class K, class V> class TreeMap {
     /**
      * Returns a key-value mapping associated with the least key in
      * this map.
-     * O(logn).
+     * O(1).
      * @throw ElementNotExist
      */
     const Entry<K, V>& firstEntry() const {
@@ -431,7 +1100,7 @@ template<class K, class V> class TreeMap {
 
     /**
      * Returns the first (lowest) key currently in this map.
-     * O(logn).
+     * O(1).
      * @throw ElementNotExist
      */
     const K& firstKey() const {
@@ -444,9 +1113,11 @@ template<class K, class V> class TreeMap {
      * O(logn).
      * @throw ElementNotExist
      */
-    V& get(const K& key) {
-        if (!containsKey(key)) throw ElementNotExist("\nNo Such Element\n");
-        return getNode(key)->value;
+    template <class K2>
+    V& get(const K2& key) {
+        Node<K, V> *node = getNode(key);
+        if (node == nil) throw ElementNotExist("\nNo Such Element\n");
+        return node->value;
     }
 
     /**
@@ -454,15 +1125,17 @@ template<class K, class V> class TreeMap {
      * O(logn).
      * @throw ElementNotExist
      */
-    const V& get(const K& key) const {
-        if (!containsKey(key)) throw ElementNotExist("\nNo Such Element\n");
-        return getNode(key)->value;
+    template <class K2>
+    const V& get(const K2& key) const {
+        Node<K, V> *node = getNode(key);
+        if (node == nil) throw ElementNotExist("\nNo Such Element\n");
+        return node->value;
     }
 
     /**
      * Returns a key-value mapping associated with the greatest key
      * in this map.
-     * O(logn).
+     * O(1).
      * @throw ElementNotExist
      */
     const Entry<K, V>& lastEntry() const {
@@ -473,7 +1146,7 @@ template<class K, class V> class TreeMap {
 
     /**
      * Returns the last (highest) key currently in this map.
-     * O(logn).
+     * O(1).
      * @throw ElementNotExist
      */
     const K& lastKey() const {
@@ -481,6 +1154,195 @@ template<class K, class V> class TreeMap {
         return lastNode()->key;
     }
 
+    /**
+     * Returns an iterator starting at the first mapping whose key is not
+     * less than key.
+     * O(logn).
+     */
+    Iterator lowerBound(const K& key) {
+        Iterator Itr;
+        Itr.init(ceilingNode(key), this);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator starting at the first mapping whose key is
+     * not less than key.
+     * O(logn).
+     */
+    ConstIterator lowerBound(const K& key) const {
+        ConstIterator CItr;
+        CItr.init(ceilingNode(key), this);
+        return CItr;
+    }
+
+    /**
+     * Returns an iterator starting at the first mapping whose key is
+     * greater than key.
+     * O(logn).
+     */
+    Iterator upperBound(const K& key) {
+        Iterator Itr;
+        Itr.init(higherNode(key), this);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator starting at the first mapping whose key is
+     * greater than key.
+     * O(logn).
+     */
+    ConstIterator upperBound(const K& key) const {
+        ConstIterator CItr;
+        CItr.init(higherNode(key), this);
+        return CItr;
+    }
+
+    /**
+     * Returns the mapping with the least key greater than or equal to key.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& ceilingEntry(const K& key) const {
+        return entryOf(ceilingNode(key));
+    }
+
+    /**
+     * Returns the mapping with the greatest key less than or equal to key.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& floorEntry(const K& key) const {
+        return entryOf(floorNode(key));
+    }
+
+    /**
+     * Returns the mapping with the least key strictly greater than key.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& higherEntry(const K& key) const {
+        return entryOf(higherNode(key));
+    }
+
+    /**
+     * Returns the mapping with the greatest key strictly less than key.
+     * O(logn).
+     * @throw ElementNotExist
+     */
+    const Entry<K, V>& lowerEntry(const K& key) const {
+        return entryOf(lowerNode(key));
+    }
+
+    /**
+     * Returns a view of the mappings whose keys range from fromKey,
+     * inclusive, to toKey, exclusive.
+     * O(1).
+     */
+    SubMap subMap(const K& fromKey, const K& toKey) {
+        return SubMap(this, fromKey, true, toKey, true);
+    }
+
+    /**
+     * Returns a view of the mappings whose keys are less than toKey.
+     * O(1).
+     */
+    SubMap headMap(const K& toKey) {
+        return SubMap(this, toKey, false, toKey, true);
+    }
+
+    /**
+     * Returns a view of the mappings whose keys are greater than or equal
+     * to fromKey.
+     * O(1).
+     */
+    SubMap tailMap(const K& fromKey) {
+        return SubMap(this, fromKey, true, fromKey, false);
+    }
+
+    /**
+     * Returns the number of keys strictly less than key.
+     * Requires the OrderStatistic augmentation.
+     * O(logn).
+     */
+    int rank(const K& key) const {
+        int res = 0;
+        Node<K, V> *current = root;
+        while (current != nil) {
+            if (C::compare(current->key, key) < 0) {
+                res += current->left->subtreeSize + 1;
+                current = current->right;
+            }
+            else current = current->left;
+        }
+        return res;
+    }
+
+    /**
+     * Returns the mapping with the k-th smallest key, counting from 0.
+     * Requires the OrderStatistic augmentation.
+     * O(logn).
+     * @throw IndexOutOfBound
+     */
+    const Entry<K, V>& select(int k) const {
+        if (k < 0 || k >= sz) throw IndexOutOfBound("\nIndex out of Bound\n");
+        Node<K, V> *current = root;
+        while (true) {
+            int leftSize = current->left->subtreeSize;
+            if (k < leftSize) current = current->left;
+            else if (k == leftSize) return *current;
+            else {
+                k -= leftSize + 1;
+                current = current->right;
+            }
+        }
+    }
+
+    /**
+     * Returns the combination, in key order, of the values whose keys range
+     * from lo, inclusive, to hi, exclusive; the identity of the monoid if
+     * there is none.
+     * Requires the RangeAggregate augmentation.
+     * O(logn).
+     */
+    typename A::AggregateValue aggregate(const K& lo, const K& hi) const {
+        typedef typename A::Monoid M;
+        typename A::AggregateValue left = M::identity(), right = M::identity();
+        if (C::compare(lo, hi) >= 0) return left;
+        Node<K, V> *split = root;
+        while (split != nil) {
+            if (C::compare(split->key, hi) >= 0) split = split->left;
+            else if (C::compare(split->key, lo) < 0) split = split->right;
+            else break;
+        }
+        if (split == nil) return left;
+        for (Node<K, V> *node = split->left; node != nil; ) {
+            if (C::compare(node->key, lo) < 0) node = node->right;
+            else {
+                left = M::combine(M::combine(node->value, node->right->agg), left);
+                node = node->left;
+            }
+        }
+        for (Node<K, V> *node = split->right; node != nil; ) {
+            if (C::compare(node->key, hi) < 0) {
+                right = M::combine(right, M::combine(node->left->agg, node->value));
+                node = node->right;
+            }
+            else node = node->left;
+        }
+        return M::combine(M::combine(left, split->value), right);
+    }
+
+    /**
+     * Returns the number of keys from lo, inclusive, to hi, exclusive.
+     * Requires the OrderStatistic augmentation.
+     * O(logn).
+     */
+    int countRange(const K& lo, const K& hi) const {
+        if (C::compare(lo, hi) >= 0) return 0;
+        return rank(hi) - rank(lo);
+    }
+
     void add(const Entry<K, V>& e) {
         put(e.key, e.value);
     }
@@ -489,31 +1351,58 @@ template<class K, class V> class TreeMap {
      * Associates the specified value with the specified key in this map.
      * Returns the previous value, if not exist, a value returned by the
      * default-constructor.
-     * O(logn).
+     * O(logn), O(1) plus rebalancing for a key greater than all the keys
+     * of the map.
      */
 
     V put(const K& key, const V& value) {
         Node<K, V> *current = root, *parent = nil;
+        int c = 0;
+        if (rightmost != nil && (c = C::compare(key, rightmost->key)) > 0) {
+            parent = rightmost;
+            current = nil;
+        }
         while (current != nil) {
             parent = current;
-            if (key > current->key) current = current->right;
-            else if (key < current->key) current = current->left;
+            c = C::compare(key, current->key);
+            if (c > 0) current = current->right;
+            else if (c < 0) current = current->left;
             else {
                 V res = current->value;
                 current->value = value;
+                refreshToRoot(current);
                 return res;
             }
         }
-        Node<K, V> *node = new Node<K, V>(key, value, RED, nil, nil, parent);
-        sz++;
-        if (parent == nil) {
-            root = node;
-            V res;
-            return res;
+        attach(parent, c, key, value);
+        V res; return res;
+    }
+
+    /**
+     * Like put, with a hint that key belongs just before the next element
+     * of the iterator hint, or at the end of the map if the iteration is
+     * over, as with an iterator from lowerBound(key). A right hint skips
+     * the descent from the root; a wrong one falls back to put.
+     * O(1) amortized plus rebalancing for a right hint, O(logn) otherwise.
+     */
+    V putHint(const Iterator& hint, const K& key, const V& value) {
+        Node<K, V> *next = hint.nxt, *prev;
+        if (hint.treeM != this || hint.descending) return put(key, value);
+        if (next != nil) {
+            int c = C::compare(key, next->key);
+            if (c == 0) {
+                V res = next->value;
+                next->value = value;
+                refreshToRoot(next);
+                return res;
+            }
+            if (c > 0) return put(key, value);
+            prev = predecessor(next);
         }
-        if (key > parent->key) parent->right = node;
-        else parent->left = node;
-        insertFixup(node);
+        else prev = rightmost;
+        if (prev != nil && C::compare(prev->key, key) >= 0) return put(key, value);
+        if (next != nil && next->left == nil) attach(next, -1, key, value);
+        else attach(prev, 1, key, value);
         V res; return res;
     }
 
@@ -522,7 +1411,8 @@ template<class K, class V> class TreeMap {
      * O(logn).
      * @throw ElementNotExist
      */
-    V remove(const K& key) {
+    template <class K2>
+    V remove(const K2& key) {
         Node<K, V> *node = getNode(key);
         if (node == nil) throw ElementNotExist("\nNo Such Element\n");
         V res = node->value;
@@ -7,31 +7,79 @@
 #include "TreeMap.h"
 
 /**
- * A set implemented by balanced tree,
- * the elements being putted must guarantee operator'<'
+ * A set implemented by balanced tree, ordered by the comparator class C.
+ * C is as for TreeMap; it defaults to Comparator<E>, the natural order,
+ * for which the elements being putted must guarantee operator'<'
  *
- * The iterator must iterates in the order defined by the operator'<' (from the smallest to the biggest)
+ * The iterator must iterates in the order defined by C (from the smallest to the biggest)
  */
 
-template <class E>
+template <class E, class C = Comparator<E> >
 class TreeSet {
     private:
-        TreeMap<E, bool>* map;
+        TreeMap<E, bool, C>* map;
+
+        /**
+         * Tells whether looking up each of the small elements in the big
+         * set (small * log(big)) is cheaper than merging both (small + big).
+         */
+        static bool preferLookup(int small, int big) {
+            int depth = 1;
+            while ((1 << depth) < big && depth < 30) depth++;
+            return (long long)small * depth < (long long)small + big;
+        }
+
+        /**
+         * The elements of a set operation's result, gathered in increasing
+         * order so that the result tree is built in one pass.
+         */
+        class SortedRun {
+            public:
+            const E **elems;
+            int cnt;
+            explicit SortedRun(int capacity): cnt(0) {
+                elems = new const E*[capacity > 0 ? capacity : 1];
+            }
+            ~SortedRun() {
+                delete [] elems;
+            }
+            void add(const E& e) {
+                elems[cnt++] = &e;
+            }
+            private:
+            SortedRun(const SortedRun &);
+            SortedRun& operator = (const SortedRun &);
+        };
+
+        class RunCursor {
+            public:
+            const E* const *p;
+            const E& next() {
+                return **p++;
+            }
+        };
+
+        explicit TreeSet(const SortedRun& run) {
+            map = new TreeMap<E, bool, C>;
+            RunCursor c;
+            c.p = run.elems;
+            map->buildFromSortedKeys(c, run.cnt, true);
+        }
     public:
     class ConstIterator {
         public:
-        typename TreeMap<E, bool>::ConstIterator mCItr;
+        typename TreeMap<E, bool, C>::ConstIterator mCItr;
         /**
          * Returns true if the iteration has more elements.
-         * O(n) for iterating through the container
+         * O(n) for iterating through the container
          */
         bool hasNext() {
             return mCItr.hasNext();
         }
-
+
         /**
          * Returns the next element in the iteration.
-         * O(n) for iterating through the container.
+         * O(n) for iterating through the container.
          * @throw ElementNotExist
          */
         const E& next() {
@@ -41,10 +89,10 @@ class TreeSet {
 
     class Iterator {
         public:
-        typename TreeMap<E, bool>::Iterator mItr;
+        typename TreeMap<E, bool, C>::Iterator mItr;
         /**
          * Returns true if the iteration has more elements.
-         * O(n) for iterating through the container.
+         * O(n) for iterating through the container.
          */
         bool hasNext() {
             return mItr.hasNext();
@@ -52,7 +100,7 @@ class TreeSet {
 
         /**
          * Returns the next element in the iteration.
-         * O(n) for iterating through the container
+         * O(n) for iterating through the container
          * @throw ElementNotExist
          */
         const E& next() {
@@ -62,7 +110,7 @@ class TreeSet {
         /**
          * Removes from the underlying collection the last element
          * returned by the iterator.
-         * O(1)
+         * O(1)
          * @throw ElementNotExist
          */
         void remove() {
@@ -70,11 +118,71 @@ class TreeSet {
         }
     };
 
+    /**
+     * A view of the elements of a TreeSet lying in a range, from an
+     * inclusive lower bound to an exclusive upper bound. See TreeMap::SubMap.
+     */
+    class SubSet {
+        public:
+        typedef typename TreeSet<E, C>::ConstIterator ConstIterator;
+        typedef typename TreeSet<E, C>::Iterator Iterator;
+
+        private:
+        typename TreeMap<E, bool, C>::SubMap view;
+
+        public:
+        SubSet(const typename TreeMap<E, bool, C>::SubMap &_view): view(_view) {}
+
+        /**
+         * Returns an iterator over the elements in this view.
+         * O(logn)
+         */
+        Iterator iterator() {
+            Iterator Itr;
+            Itr.mItr = view.iterator();
+            return Itr;
+        }
+
+        /**
+         * Returns an const iterator over the elements in this view.
+         * O(logn)
+         */
+        ConstIterator constIterator() const {
+            ConstIterator CItr;
+            CItr.mCItr = view.constIterator();
+            return CItr;
+        }
+
+        /**
+         * Returns true if the element lies in the range and is in the set.
+         * O(logn)
+         */
+        bool contains(const E& e) const {
+            return view.containsKey(e);
+        }
+
+        /**
+         * Returns true if no element of the set lies in the range.
+         * O(logn)
+         */
+        bool isEmpty() const {
+            return view.isEmpty();
+        }
+
+        /**
+         * Returns the number of elements in this view.
+         * O(logn + k), k being the result.
+         */
+        int size() const {
+            return view.size();
+        }
+    };
+
     /**
      * Constructs a new, empty tree set, sorted according to the natural ordering of its elements.
      */
     TreeSet() { 
-        map = new TreeMap<E, bool>;
+        map = new TreeMap<E, bool, C>;
     }
 
     /**
@@ -83,7 +191,7 @@ class TreeSet {
      */
     template <class E2>
     explicit TreeSet(const E2& x) { 
-        map = new TreeMap<E, bool>;
+        map = new TreeMap<E, bool, C>;
         addAll(*this, x);
     }
 
@@ -106,8 +214,7 @@ class TreeSet {
      * Copy-constructor
      */
     TreeSet(const TreeSet& x) { 
-        map = new TreeMap<E, bool>;
-        addAll(*this, x);
+        map = new TreeMap<E, bool, C>(*x.map);
     }
 
     /**
@@ -128,10 +235,29 @@ class TreeSet {
         return CItr;
     }
 
+    /**
+     * Returns an iterator over the elements in this set in descending order.
+     */
+    Iterator descendingIterator() {
+        Iterator Itr;
+        Itr.mItr = map->descendingIterator();
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator over the elements in this set in descending
+     * order.
+     */
+    ConstIterator descendingIterator() const {
+        ConstIterator CItr;
+        CItr.mCItr = ((const TreeMap<E, bool, C>*)map)->descendingIterator();
+        return CItr;
+    }
+
     /**
      * Adds the specified element to this set if it is not already present.
      * Returns true if this set did not already contain the specified element.
-     * O(logn)
+     * O(logn)
      */
     bool add(const E& e) { 
         if (map->containsKey(e)) return false;
@@ -148,7 +274,7 @@ class TreeSet {
 
     /**
      * Returns true if this set contains the specified element.
-     * O(logn)
+     * O(logn)
      */
     bool contains(const E& e) const { 
         return map->containsKey(e);
@@ -156,7 +282,7 @@ class TreeSet {
 
     /**
      * Returns a const reference to the first (lowest) element currently in this set.
-     * O(logn)
+     * O(1)
      * @throw ElementNotExist
      */
     const E& first() const { 
@@ -166,7 +292,7 @@ class TreeSet {
 
     /**
      * Returns true if this set contains no elements.
-     * O(1)
+     * O(1)
      */
     bool isEmpty() const { 
         return map->isEmpty();
@@ -174,7 +300,7 @@ class TreeSet {
 
     /**
      * Returns a const reference to the last (highest) element currently in this set.
-     * O(logn)
+     * O(1)
      * @throw ElementNotExist
      */
     const E& last() const { 
@@ -184,7 +310,7 @@ class TreeSet {
 
     /**
      * Removes the specified element from this set if it is present.
-     * O(logn)
+     * O(logn)
      */
     bool remove(const E& e) { 
         if (!map->containsKey(e)) return false;
@@ -194,10 +320,228 @@ class TreeSet {
 
     /**
      * Returns the number of elements in this set (its cardinality).
-     * O(1)
+     * O(1)
      */
     int size() const { 
         return map->size();
     }
+
+    /**
+     * Returns the least element greater than or equal to e.
+     * O(logn)
+     * @throw ElementNotExist
+     */
+    const E& ceiling(const E& e) const {
+        return map->ceilingEntry(e).key;
+    }
+
+    /**
+     * Returns the greatest element less than or equal to e.
+     * O(logn)
+     * @throw ElementNotExist
+     */
+    const E& floor(const E& e) const {
+        return map->floorEntry(e).key;
+    }
+
+    /**
+     * Returns the least element strictly greater than e.
+     * O(logn)
+     * @throw ElementNotExist
+     */
+    const E& higher(const E& e) const {
+        return map->higherEntry(e).key;
+    }
+
+    /**
+     * Returns the greatest element strictly less than e.
+     * O(logn)
+     * @throw ElementNotExist
+     */
+    const E& lower(const E& e) const {
+        return map->lowerEntry(e).key;
+    }
+
+    /**
+     * Returns an iterator starting at the first element not less than e.
+     * O(logn)
+     */
+    Iterator lowerBound(const E& e) {
+        Iterator Itr;
+        Itr.mItr = map->lowerBound(e);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator starting at the first element not less than e.
+     * O(logn)
+     */
+    ConstIterator lowerBound(const E& e) const {
+        ConstIterator CItr;
+        CItr.mCItr = ((const TreeMap<E, bool, C>*)map)->lowerBound(e);
+        return CItr;
+    }
+
+    /**
+     * Returns an iterator starting at the first element greater than e.
+     * O(logn)
+     */
+    Iterator upperBound(const E& e) {
+        Iterator Itr;
+        Itr.mItr = map->upperBound(e);
+        return Itr;
+    }
+
+    /**
+     * Returns an const iterator starting at the first element greater than e.
+     * O(logn)
+     */
+    ConstIterator upperBound(const E& e) const {
+        ConstIterator CItr;
+        CItr.mCItr = ((const TreeMap<E, bool, C>*)map)->upperBound(e);
+        return CItr;
+    }
+
+    /**
+     * Returns a view of the elements ranging from fromElement, inclusive,
+     * to toElement, exclusive.
+     * O(1)
+     */
+    SubSet subSet(const E& fromElement, const E& toElement) {
+        return SubSet(map->subMap(fromElement, toElement));
+    }
+
+    /**
+     * Returns a view of the elements less than toElement.
+     * O(1)
+     */
+    SubSet headSet(const E& toElement) {
+        return SubSet(map->headMap(toElement));
+    }
+
+    /**
+     * Returns a view of the elements greater than or equal to fromElement.
+     * O(1)
+     */
+    SubSet tailSet(const E& fromElement) {
+        return SubSet(map->tailMap(fromElement));
+    }
+
+    /**
+     * Returns a new set containing the elements in either this set or x.
+     * Both sets are walked once in order, like the merge step of merge sort,
+     * and the result tree is built directly from the merged sequence.
+     * O(n + m)
+     */
+    TreeSet unionWith(const TreeSet& x) const {
+        SortedRun res(size() + x.size());
+        ConstIterator a = constIterator(), b = x.constIterator();
+        const E *p = a.hasNext() ? &a.next() : NULL, *q = b.hasNext() ? &b.next() : NULL;
+        while (p != NULL || q != NULL) {
+            int c = q == NULL ? -1 : p == NULL ? 1 : C::compare(*p, *q);
+            if (c < 0) {
+                res.add(*p);
+                p = a.hasNext() ? &a.next() : NULL;
+            }
+            else if (c > 0) {
+                res.add(*q);
+                q = b.hasNext() ? &b.next() : NULL;
+            }
+            else {
+                res.add(*p);
+                p = a.hasNext() ? &a.next() : NULL;
+                q = b.hasNext() ? &b.next() : NULL;
+            }
+        }
+        return TreeSet(res);
+    }
+
+    /**
+     * Returns a new set containing the elements in both this set and x.
+     * When one set is much smaller, its elements are looked up in the
+     * other; otherwise both are merged in order.
+     * O(min(m log n, n + m))
+     */
+    TreeSet intersectWith(const TreeSet& x) const {
+        const TreeSet &big = size() >= x.size() ? *this : x, &small = size() >= x.size() ? x : *this;
+        SortedRun res(small.size());
+        if (preferLookup(small.size(), big.size())) {
+            ConstIterator a = small.constIterator();
+            while (a.hasNext()) {
+                const E &e = a.next();
+                if (big.contains(e)) res.add(e);
+            }
+            return TreeSet(res);
+        }
+        ConstIterator a = constIterator(), b = x.constIterator();
+        const E *p = a.hasNext() ? &a.next() : NULL, *q = b.hasNext() ? &b.next() : NULL;
+        while (p != NULL && q != NULL) {
+            int c = C::compare(*p, *q);
+            if (c < 0) p = a.hasNext() ? &a.next() : NULL;
+            else if (c > 0) q = b.hasNext() ? &b.next() : NULL;
+            else {
+                res.add(*p);
+                p = a.hasNext() ? &a.next() : NULL;
+                q = b.hasNext() ? &b.next() : NULL;
+            }
+        }
+        return TreeSet(res);
+    }
+
+    /**
+     * Returns a new set containing the elements in this set but not in x.
+     * If this set is much smaller, its elements are looked up in x;
+     * otherwise both are merged in order.
+     * O(min(n log m, n + m))
+     */
+    TreeSet differenceWith(const TreeSet& x) const {
+        SortedRun res(size());
+        if (preferLookup(size(), x.size())) {
+            ConstIterator a = constIterator();
+            while (a.hasNext()) {
+                const E &e = a.next();
+                if (!x.contains(e)) res.add(e);
+            }
+            return TreeSet(res);
+        }
+        ConstIterator a = constIterator(), b = x.constIterator();
+        const E *p = a.hasNext() ? &a.next() : NULL, *q = b.hasNext() ? &b.next() : NULL;
+        while (p != NULL) {
+            int c = q == NULL ? -1 : C::compare(*p, *q);
+            if (c < 0) {
+                res.add(*p);
+                p = a.hasNext() ? &a.next() : NULL;
+            }
+            else if (c > 0) q = b.hasNext() ? &b.next() : NULL;
+            else {
+                p = a.hasNext() ? &a.next() : NULL;
+                q = b.hasNext() ? &b.next() : NULL;
+            }
+        }
+        return TreeSet(res);
+    }
+
+    /**
+     * Returns true if this set and x have no element in common.
+     * O(min(m log n, n + m))
+     */
+    bool isDisjoint(const TreeSet& x) const {
+        const TreeSet &big = size() >= x.size() ? *this : x, &small = size() >= x.size() ? x : *this;
+        if (preferLookup(small.size(), big.size())) {
+            ConstIterator a = small.constIterator();
+            while (a.hasNext())
+                if (big.contains(a.next())) return false;
+            return true;
+        }
+        ConstIterator a = constIterator(), b = x.constIterator();
+        const E *p = a.hasNext() ? &a.next() : NULL, *q = b.hasNext() ? &b.next() : NULL;
+        while (p != NULL && q != NULL) {
+            int c = C::compare(*p, *q);
+            if (c < 0) p = a.hasNext() ? &a.next() : NULL;
+            else if (c > 0) q = b.hasNext() ? &b.next() : NULL;
+            else return false;
+        }
+        return true;
+    }
 };
 #endif
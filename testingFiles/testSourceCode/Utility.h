@@ -52,6 +52,58 @@ inline int compareTo(const C1 &a, const C2 &b) {
     return 0;
 }
 
+/**
+ * The natural ordering (operator<), as a comparator.
+ * A comparator is a class with a static function named ``compare'' which
+ * returns a negative number, zero or a positive number as a is less than,
+ * equal to or greater than b. For example, the following class
+ * @code
+ *      class Descending {
+ *      public:
+ *          static int compare(int a, int b) {
+ *              return b - a;
+ *          }
+ *      };
+ * @endcode
+ * sorts integers from the biggest to the smallest.
+ */
+template<class T>
+class Comparator {
+public:
+    static int compare(const T &a, const T &b) {
+        if (a < b) return -1;
+        if (b < a) return 1;
+        return 0;
+    }
+
+    /**
+     * Compares a value of another type with a T, for lookups by a key
+     * which is not a T, without converting it.
+     */
+    template<class T2>
+    static int compare(const T2 &a, const T &b) {
+        if (a < b) return -1;
+        if (b < a) return 1;
+        return 0;
+    }
+};
+
+/**
+ * Strings are compared in a single pass by std::string::compare.
+ */
+template<>
+class Comparator<std::string> {
+public:
+    static int compare(const std::string &a, const std::string &b) {
+        return a.compare(b);
+    }
+
+    template<class T2>
+    static int compare(const T2 &a, const std::string &b) {
+        return -b.compare(a);
+    }
+};
+
 /**
  * Thrown when an index is out of range
  * For example, list.get(10); while list.size() == 5 raises this exception.